@@ -1,475 +1,1096 @@
-#include "SAT-solver.hpp"
-#include "cnf_io.hpp"
-
-class Clause {
-    public:
-        literal *literals;
-        int n;
-        Clause(literal *literals, int n);
-        int can_be_simplified_with(literal lit, literal *lit_out);
-        void print();
-};
-
-Clause::Clause(literal *literals, int n) {
-    this->literals = literals;
-    this->n = n;
-}
-
-/**
- * Determines whether the clause can be simplified with a given literal.
- * Returns true if the given literal's variable is contained in its array of literals.
-*/
-int Clause::can_be_simplified_with(literal lit, literal *lit_out) {
-    for (int i = 1; i < n; i++) {
-        if (lit.var == this->literals[i].var) {
-            // Clause contains given literal's variable, thus can be simplified with given literal
-            *lit_out = {this->literals[i].var, this->literals[i].positive};
-            return 1;
-        }
-    }
-
-    return 0;
-}
-
-void Clause::print() {
-    for (int i = 0; i < n; i++) {
-        if (!literals[i].positive) cout << "-";
-        cout << literals[i].var << " ";
-    }
-}
-
-class Sequent {
-    public:
-        Clause **clause_set;
-        int n;
-        queue<int> single_clause_indexes;
-        map<uint32_t, int> var_count;
-        Sequent(Clause **clause_set, int n);
-        bool is_axiom();
-        bool propagate();
-};
-
-Sequent::Sequent(Clause **clause_set, int n) {
-    this->clause_set = clause_set;
-    this->n = n;
-}
-
-/**
- * Determining whether the sequent is an axiom or not.
- * A sequent is an axiom if the sequent is true for all possible interpretations.
-*/
-bool Sequent::is_axiom() {
-    for (int i = 0; i < n; i++) {
-        if (clause_set[i]->n == 0)
-            // Axiom by empty clause
-            return true;
-        // skips if clause' length is not 1
-        if (clause_set[i]->n != 1) continue;
-
-        literal this_lit = clause_set[i]->literals[0];
-
-        for (int j = 0; j < n; j++) {
-            if (i == j) continue;
-            if (clause_set[j]->n != 1) continue;
-            literal other_lit = clause_set[j]->literals[0];
-            // Checks if first literal's variable is equal to second literal's variable,
-            // and if respective literal's negation is different.
-            if (this_lit.var == other_lit.var && this_lit.positive != other_lit.positive)
-                // Axiom
-                return true;
-        }
-    }
-    return false;
-}
-
-/**
- * Applies unit propagation on a sequent.
- * I.e. for all single literal clauses in it's clause set,
- * remove all clauses containing the single literal from the clause set,
- * and remove the negated literal from any clause' literals array where the negated
- * literal of the single literal is included.
-*/
-bool Sequent::propagate() {
-    while (!single_clause_indexes.empty()) {
-        int i = single_clause_indexes.front();
-        if (i > n || clause_set[i]->n != 1) {
-            // Clause contains more than one literal or clause index is out of bounds.
-            single_clause_indexes.pop();
-            continue;
-        }
-        
-        literal lit = clause_set[i]->literals[0];
-        for (int j = 0; j < n; j++) {
-            literal simplify_with;
-            if (clause_set[j]->can_be_simplified_with(lit, &simplify_with)) {
-                if (lit.positive != simplify_with.positive) {
-                    // Unit resolution
-                    // Remove the atom from the clause' literals array
-                    for (int k = 0; k < clause_set[j]->n; k++) {
-                        if (clause_set[j]->literals[k].var == simplify_with.var && clause_set[j]->literals[k].positive == simplify_with.positive) {
-                            clause_set[j]->literals[k] = clause_set[j]->literals[--clause_set[j]->n];
-                            if (clause_set[j]->n == 1) single_clause_indexes.push(j);
-                            break;
-                        }
-                    }
-                } else {
-                    // Unit subsumption
-                    // Remove the whole clause
-                    if (clause_set[--n]->n == 1) single_clause_indexes.push(j);
-                    free_clause(clause_set[j]);
-                    clause_set[j] = clause_set[n];
-                }
-
-                return true;
-            }
-        }
-        single_clause_indexes.pop();
-    }
-
-    return false;
-}
-
-/**
- * Chooses the variable with the most occurences regardless of negation.
-*/
-uint32_t choose_cut_var(Sequent *seq) {
-    int max = 0;
-    uint32_t var = 0;
-
-    for (auto const& [key, count] : seq->var_count) {
-        if (count > max) {
-            max = count;
-            var = key;
-        }
-    }
-
-    if (max == 1) return 0;
-    return var;
-}
-
-/**
- * Creates a new sequent with atomic cut applied based on chosen variable.
-*/
-Sequent *atomic_cut_create_sequent(Clause **clause_set, int n, uint32_t var, bool val) {
-    // Creates a new sequent
-    literal this_lit = {var, val};
-    literal *literals = new literal[1];
-    literals[0] = this_lit;
-
-    Clause *cl = new Clause(literals, 1);
-    Clause **cl_set = new Clause*[n+1];
-    int c_num = 0;
-
-    queue<int> single_clause_indexes;
-    map<uint32_t, int> var_count;
-
-    for (int i = 0; i < n; i++) {
-        bool keep = true;
-        for (int j = 0; j < clause_set[i]->n; j++) {
-            literal other_lit = clause_set[i]->literals[j];
-            if (other_lit.var == this_lit.var && other_lit.positive == this_lit.positive) {
-                // Unit resolution, ignores clause
-                keep = false;
-                break;
-            }
-        }
-        if (keep) {
-            for (int j = 0; j < clause_set[i]->n; j++) {
-                literal l = clause_set[i]->literals[j];
-                if (l.var != var) {
-                    if (var_count.find(l.var) != var_count.end()) {
-                        // Increment count by 1
-                        var_count[l.var]++;
-                    } else {
-                        var_count[l.var] = 1;
-                    }
-                }
-            }
-            cl_set[c_num] = deep_cp_clause(clause_set[i], this_lit.var);
-            if (cl_set[c_num]->n == 1) {
-                // Save single clause index
-                single_clause_indexes.push(c_num);
-            }
-            c_num++;
-        }
-    }
-
-    cl_set[c_num] = cl;
-    Sequent *seq = new Sequent(cl_set, c_num+1);
-    seq->single_clause_indexes = single_clause_indexes;
-    seq->var_count = var_count;
-
-    return seq;
-}
-
-uint32_t atomic_cut_is_possible(Sequent *seq) {
-    return choose_cut_var(seq);
-}
-
-/**
- * Applies atomic cut to a sequent to achieve atomic cut elimination.
- * Returns a left- and right sequent each with an additional clause
- * containing a single negated- and non-negated variable respectively.
- * The chosen variable is chosen strategically.
- * Returns 0 if atomic cut cannot be applied.
-*/
-void apply_atomic_cut(Sequent *seq, Sequent **left, Sequent **right, uint32_t var) {
-    Clause **clause_set = seq->clause_set;
-    int n = seq->n;
-
-    // Sets the left Sequent
-    *left = atomic_cut_create_sequent(clause_set, n, var, true);
-    // Sets the right Sequent
-    *right = atomic_cut_create_sequent(clause_set, n, var, false);
-}
-
-/**
- * Deep copies a clause.
-*/
-Clause* deep_cp_clause(Clause* cl, uint32_t ignore_var) {
-    int n = cl->n;
-    literal *literals = new literal[n];
-    int c_i = 0;
-
-    for (int i = 0; i < n; i++) {
-        if (cl->literals[i].var == ignore_var) continue; // Unit resolution
-        literal lit = {cl->literals[i].var, cl->literals[i].positive};
-        literals[c_i] = lit;
-        c_i++;
-    }
-
-    Clause *clause = new Clause(literals, c_i);
-    return clause;
-}
-
-void free_clause(Clause *cl) {
-    delete []cl->literals;
-    delete cl;
-}
-
-void free_sequent(Sequent *seq) {
-    for (int i = 0; i < seq->n; i++)
-        free_clause(seq->clause_set[i]);
-    delete [](seq->clause_set);
-    delete seq;
-}
-
-void free_remaining_sequents(vector<Sequent*> *stack) {
-    while ((*stack).size() > 0) {
-        Sequent *seq = (*stack).back();
-        free_sequent(seq);
-        (*stack).pop_back();
-    }
-}
-
-void print_clause_set(Clause** clause_set, int n) {
-    for (int i = 0; i < n; i++) {
-        clause_set[i]->print();
-        cout << endl;
-    }
-}
-
-bool prove(Sequent *seq) {
-    // Simplifies the sequent as much as possible
-    while (seq->propagate());
-
-    // Abandons branch if the now-simplified sequent is an axiom
-    if (seq->is_axiom()) {
-        free_sequent(seq);
-        return 0;
-    }
-
-    uint32_t var = atomic_cut_is_possible(seq);
-
-    // Sequent is satisfiable if atomic cut is impossible and sequent is not an axiom
-    if (var == 0) {
-        cout << "s SATISFIABLE" << endl;
-        cout << "v ";
-        for (int i = 0; i < seq->n; i++) {
-            literal lit = seq->clause_set[i]->literals[0];
-            if (!lit.positive) cout << "-";
-            cout << lit.var << " ";
-        }
-        cout << "0" << endl;
-        free_sequent(seq);
-        return 1;
-    }
-
-    // Applies atomic cut, abandoning current sequent
-    Sequent *left;
-    Sequent *right;
-    apply_atomic_cut(seq, &left, &right, var);
-    free_sequent(seq);
-
-    if (prove(left) == 1) {
-        // Satisfiable
-        free_sequent(right);
-        return 1;
-    }
-
-    if (prove(right) == 1) {
-        // Satisfiable
-        return 1;
-    }
-
-    return 0;
-}
-
-/**
- * Determines the satisfiability of a clause set.
- * Writes 's SATISIFABLE' followed by solution, or 's UNSATISFIABLE' to stdout.
-*/
-void solve(Clause **clause_set, int n) {
-    Sequent *seq = new Sequent(clause_set, n);
-    map<uint32_t, int> var_count;
-
-    // Find indexes of all one-literal clauses
-    for (int i = 0; i < n; i++) {
-        if (seq->clause_set[i]->n == 1) seq->single_clause_indexes.push(i);
-        for (int j = 0; j < seq->clause_set[i]->n; j++) {
-            literal lit = seq->clause_set[i]->literals[j];
-            if (var_count.find(lit.var) != var_count.end()) {
-                // Increment count by 1
-                var_count[lit.var]++;
-            } else {
-                var_count[lit.var] = 1;
-            }
-        }
-    }
-    seq->var_count = var_count;
-
-    bool res = prove(seq);
-    if (res == 0) {
-        // Unsatisfiable
-        cout << "s UNSATISFIABLE" << endl;
-    }
-}
-
-/**
- * Reads a formula in CNF from file.
- * Functions for parsing of cnf files authored by John Burkardt.
- * Returns formula as a clause set.
-*/
-Clause** read_cnf_file(string filename, int *n) {
-    int v_num, c_num, l_num;
-    cnf_header_read(filename, &v_num, &c_num, &l_num);
-
-    int *l_c_num = new int[c_num+1];
-    int *l_val = new int[l_num];
-    cnf_data_read(filename, v_num, c_num, l_num, l_c_num, l_val);
-
-    Clause **clause_set = new Clause*[c_num];
-    int c_num2 = 0;
-    int l_num2 = 0;
-
-    while (1) {
-        if (c_num2 == c_num) break;
-
-        int num_literals = l_c_num[c_num2];
-        literal* literals = new literal[num_literals];
-
-        for (int i = 0; i < num_literals; i++) {
-            int var = l_val[l_num2];
-            bool positive = var > 0;
-            literal lit = {(uint32_t) abs(var), positive};
-            literals[i] = lit;
-            l_num2++;
-        }
-
-        Clause *cl = new Clause(literals, num_literals);
-        clause_set[c_num2] = cl;
-        c_num2++;
-    }
-
-    *n = c_num;
-    delete []l_c_num;
-    delete []l_val;
-
-    return clause_set;
-}
-
-/**
- * Builds a full clause set from the given variables.
- * The full clause set will be unsatisfiable.
- * n variables -> 2^n clauses.
-*/
-Clause** build_full_clause_set(int num_vars) {
-    Clause **clause_set = new Clause*[(int)pow(2, num_vars)];
-
-    for (int i = 0; i < pow(2, num_vars); i++) {
-        literal* literals = new literal[num_vars];
-        for (uint32_t j = 0; j < (uint32_t) num_vars; j++) {
-            // Determines negation with this formula
-            bool positive = int(i / (pow(2, num_vars) / pow(2, j + 1))) % 2 == 0;
-            literal lit = {j+1, positive};
-            literals[j] = lit;
-        }
-        Clause *cl = new Clause(literals, num_vars);
-        clause_set[i] = cl;
-    }
-
-    return clause_set;
-}
-
-/** 20sek
- * Tests two formulae in CNF with n variables.
- * The first formula proven is a full clause set of 2^n clauses (unsatisfiable).
- * The second formula is an almost full clause set of 2^n-1 clauses (satisfiable).
-*/
-void test(int num_variables) {
-    cout << "c Testing sequent with " << num_variables << " variables (" << pow(2, num_variables) << " clauses)" << endl;
-
-    cout << "c Unsatisfiable test:" << endl;
-    Clause** cl1 = build_full_clause_set(num_variables);
-    solve(cl1, pow(2, num_variables));
-    
-    cout << "c Satisfiable test:" << endl;
-    Clause** cl2 = build_full_clause_set(num_variables);
-    free_clause(cl2[int(pow(2, num_variables))-1]);
-    solve(cl2, int(pow(2, num_variables))-1);
-}
-
-int main(int argc, char** argv) {
-    // Parse command line arguments
-    int test_val = 0;
-    string file_name;
-
-    for (int i = 1; i < argc; ++i) {
-        string arg(argv[i]);
-        if (arg == "-test") {
-            // Test flag
-            if (++i >= argc) {
-                cerr << "Error: please provide the value of the test flag (int)" << endl;
-                return 1;
-            }
-            test_val = stoi(argv[i]);
-        } else {
-            // File name
-            file_name = arg;
-        }
-    }
-
-    // Check that only one of test flag or file name was specified
-    if ((test_val == 0 && file_name.empty()) || (test_val != 0 && !file_name.empty())) {
-        cerr << "Error: please specify either a test flag or a file name, but not both." << endl;
-        return 1;
-    }
-
-    if (test_val != 0) {
-        if (test_val < 0) {
-            cerr << "Error: test flag must be higher than 0" << endl;
-            return 1;
-        }
-        // run test
-        test(test_val);
-    } else {
-        // prove CNF formula from file
-        int n;
-        Clause **clause_set = read_cnf_file(file_name, &n);
-
-        cout << "c Solving " << file_name << endl;
-        solve(clause_set, n);
-    }
-
-    return 0;
-}
\ No newline at end of file
+#include <algorithm>
+#include <climits>
+#include "SAT-solver.hpp"
+#include "cnf_io.hpp"
+#include "classify.hpp"
+#include "parallel.hpp"
+#include "portfolio.hpp"
+#include "cdcl.hpp"
+#include "cube.hpp"
+#include "enumerate.hpp"
+#include "count.hpp"
+#include "maxsat.hpp"
+#include "core.hpp"
+#include "proof.hpp"
+#include "backbone.hpp"
+#include "stats.hpp"
+#include "trace.hpp"
+#include "checkpoint.hpp"
+
+Clause::Clause(literal *literals, int n) {
+    this->literals = literals;
+    this->n = n;
+}
+
+/**
+ * Determines whether the clause can be simplified with a given literal.
+ * Returns true if the given literal's variable is contained in its array of literals.
+*/
+int Clause::can_be_simplified_with(literal lit, literal *lit_out) {
+    for (int i = 1; i < n; i++) {
+        if (lit.var == this->literals[i].var) {
+            // Clause contains given literal's variable, thus can be simplified with given literal
+            *lit_out = {this->literals[i].var, this->literals[i].positive};
+            return 1;
+        }
+    }
+
+    return 0;
+}
+
+void Clause::print() {
+    for (int i = 0; i < n; i++) {
+        if (!literals[i].positive) cout << "-";
+        cout << literals[i].var << " ";
+    }
+}
+
+Sequent::Sequent(Clause **clause_set, int n) {
+    this->clause_set = clause_set;
+    this->n = n;
+}
+
+/**
+ * Adds the estimated heap memory of the sequent to the accounting: its clauses under the given
+ * category, its occurrence counts and unit queue as heuristics. Done once, when the sequent is complete.
+*/
+void Sequent::account_memory(memory_category category) {
+    clause_category = category;
+    clause_bytes = sizeof(Sequent) + n * sizeof(Clause*);
+    for (int i = 0; i < n; i++) clause_bytes += sizeof(Clause) + clause_set[i]->n * sizeof(literal);
+    // A tree node per counted variable, and the 512 byte blocks of the queue
+    heuristic_bytes = var_count.size() * (4 * sizeof(void*) + sizeof(pair<const uint32_t, int>)) +
+                      (single_clause_indexes.size() * sizeof(int) / 512 + 1) * 512;
+    memory_add(clause_category, clause_bytes);
+    memory_add(MEM_HEURISTICS, heuristic_bytes);
+}
+
+/**
+ * Determining whether the sequent is an axiom or not.
+ * A sequent is an axiom if the sequent is true for all possible interpretations.
+*/
+bool Sequent::is_axiom() {
+    TRACE_SCOPE("is_axiom");
+    for (int i = 0; i < n; i++) {
+        if (clause_set[i]->n == 0)
+            // Axiom by empty clause
+            return true;
+        // skips if clause' length is not 1
+        if (clause_set[i]->n != 1) continue;
+
+        literal this_lit = clause_set[i]->literals[0];
+
+        for (int j = 0; j < n; j++) {
+            if (i == j) continue;
+            if (clause_set[j]->n != 1) continue;
+            literal other_lit = clause_set[j]->literals[0];
+            // Checks if first literal's variable is equal to second literal's variable,
+            // and if respective literal's negation is different.
+            if (this_lit.var == other_lit.var && this_lit.positive != other_lit.positive)
+                // Axiom
+                return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * Applies unit propagation on a sequent.
+ * I.e. for all single literal clauses in it's clause set,
+ * remove all clauses containing the single literal from the clause set,
+ * and remove the negated literal from any clause' literals array where the negated
+ * literal of the single literal is included.
+*/
+bool Sequent::propagate() {
+    while (!single_clause_indexes.empty()) {
+        int i = single_clause_indexes.front();
+        if (i > n || clause_set[i]->n != 1) {
+            // Clause contains more than one literal or clause index is out of bounds.
+            single_clause_indexes.pop();
+            continue;
+        }
+        
+        literal lit = clause_set[i]->literals[0];
+        for (int j = 0; j < n; j++) {
+            literal simplify_with;
+            if (clause_set[j]->can_be_simplified_with(lit, &simplify_with)) {
+                if (lit.positive != simplify_with.positive) {
+                    // Unit resolution
+                    // Remove the atom from the clause' literals array
+                    for (int k = 0; k < clause_set[j]->n; k++) {
+                        if (clause_set[j]->literals[k].var == simplify_with.var && clause_set[j]->literals[k].positive == simplify_with.positive) {
+                            clause_set[j]->literals[k] = clause_set[j]->literals[--clause_set[j]->n];
+                            if (clause_set[j]->n == 1) single_clause_indexes.push(j);
+                            break;
+                        }
+                    }
+                } else {
+                    // Unit subsumption
+                    // Remove the whole clause
+                    if (clause_set[--n]->n == 1) single_clause_indexes.push(j);
+                    free_clause(clause_set[j]);
+                    clause_set[j] = clause_set[n];
+                }
+
+                return true;
+            }
+        }
+        single_clause_indexes.pop();
+    }
+
+    return false;
+}
+
+/**
+ * Chooses the variable with the most occurences regardless of negation.
+*/
+uint32_t choose_cut_var(Sequent *seq) {
+    TRACE_SCOPE("choose_cut_var");
+    int max = 0;
+    uint32_t var = 0;
+
+    for (auto const& [key, count] : seq->var_count) {
+        if (count > max) {
+            max = count;
+            var = key;
+        }
+    }
+
+    if (max == 1) return 0;
+    return var;
+}
+
+static uint32_t next_random(uint32_t *state) {
+    // xorshift32
+    *state ^= *state << 13;
+    *state ^= *state >> 17;
+    *state ^= *state << 5;
+    return *state;
+}
+
+/**
+ * Chooses the cut variable according to a search configuration.
+ * Like choose_cut_var(), returns 0 when no variable occurs more than once.
+*/
+uint32_t choose_cut_var(Sequent *seq, const search_config &config, uint32_t *rng) {
+    if (config.heuristic == CUT_MOST_OCCURRENCES) return choose_cut_var(seq);
+
+    int max = 0;
+    long total = 0;
+    for (auto const& [key, count] : seq->var_count) {
+        if (count > max) max = count;
+        if (count > 1) total += count;
+    }
+
+    if (max <= 1) return 0;
+
+    uint32_t var = 0;
+    if (config.heuristic == CUT_MOST_OCCURRENCES_RANDOM_TIES) {
+        // Reservoir sampling among the variables with the most occurences
+        uint32_t ties = 0;
+        for (auto const& [key, count] : seq->var_count) {
+            if (count != max) continue;
+            if (next_random(rng) % ++ties == 0) var = key;
+        }
+    } else {
+        // Random variable, chosen with probability proportional to its occurences
+        long pick = next_random(rng) % total;
+        for (auto const& [key, count] : seq->var_count) {
+            if (count <= 1) continue;
+            var = key;
+            pick -= count;
+            if (pick < 0) break;
+        }
+    }
+
+    return var;
+}
+
+/**
+ * Determines whether the branch setting the cut variable to true is explored first.
+*/
+bool choose_positive_first(const search_config &config, uint32_t *rng) {
+    if (config.polarity == POLARITY_POSITIVE) return true;
+    if (config.polarity == POLARITY_NEGATIVE) return false;
+    return next_random(rng) & 1;
+}
+
+/**
+ * Creates a new sequent with atomic cut applied based on chosen variable.
+*/
+Sequent *atomic_cut_create_sequent(Clause **clause_set, int n, uint32_t var, bool val) {
+    // Creates a new sequent
+    literal this_lit = {var, val};
+    literal *literals = new literal[1];
+    literals[0] = this_lit;
+
+    Clause *cl = new Clause(literals, 1);
+    Clause **cl_set = new Clause*[n+1];
+    int c_num = 0;
+
+    queue<int> single_clause_indexes;
+    occurrence_map var_count;
+
+    for (int i = 0; i < n; i++) {
+        bool keep = true;
+        for (int j = 0; j < clause_set[i]->n; j++) {
+            literal other_lit = clause_set[i]->literals[j];
+            if (other_lit.var == this_lit.var && other_lit.positive == this_lit.positive) {
+                // Unit resolution, ignores clause
+                keep = false;
+                break;
+            }
+        }
+        if (keep) {
+            for (int j = 0; j < clause_set[i]->n; j++) {
+                literal l = clause_set[i]->literals[j];
+                if (l.var != var) {
+                    if (var_count.find(l.var) != var_count.end()) {
+                        // Increment count by 1
+                        var_count[l.var]++;
+                    } else {
+                        var_count[l.var] = 1;
+                    }
+                }
+            }
+            cl_set[c_num] = deep_cp_clause(clause_set[i], this_lit.var);
+            if (cl_set[c_num]->n == 1) {
+                // Save single clause index
+                single_clause_indexes.push(c_num);
+            }
+            c_num++;
+        }
+    }
+
+    cl_set[c_num] = cl;
+    Sequent *seq = new Sequent(cl_set, c_num+1);
+    seq->single_clause_indexes = move(single_clause_indexes);
+    seq->var_count = move(var_count);
+    seq->account_memory(MEM_SEQUENT_COPIES);
+
+    return seq;
+}
+
+uint32_t atomic_cut_is_possible(Sequent *seq) {
+    return choose_cut_var(seq);
+}
+
+/**
+ * Applies atomic cut to a sequent to achieve atomic cut elimination.
+ * Returns a left- and right sequent each with an additional clause
+ * containing a single negated- and non-negated variable respectively.
+ * The chosen variable is chosen strategically.
+ * Returns 0 if atomic cut cannot be applied.
+*/
+void apply_atomic_cut(Sequent *seq, Sequent **left, Sequent **right, uint32_t var) {
+    TRACE_SCOPE("apply_atomic_cut");
+    Clause **clause_set = seq->clause_set;
+    int n = seq->n;
+
+    // Sets the left Sequent
+    *left = atomic_cut_create_sequent(clause_set, n, var, true);
+    // Sets the right Sequent
+    *right = atomic_cut_create_sequent(clause_set, n, var, false);
+    (*left)->depth = seq->depth + 1;
+    (*right)->depth = seq->depth + 1;
+}
+
+/**
+ * Deep copies a clause.
+*/
+Clause* deep_cp_clause(Clause* cl, uint32_t ignore_var) {
+    int n = cl->n;
+    literal *literals = new literal[n];
+    int c_i = 0;
+
+    for (int i = 0; i < n; i++) {
+        if (cl->literals[i].var == ignore_var) continue; // Unit resolution
+        literal lit = {cl->literals[i].var, cl->literals[i].positive};
+        literals[c_i] = lit;
+        c_i++;
+    }
+
+    Clause *clause = new Clause(literals, c_i);
+    return clause;
+}
+
+void free_clause(Clause *cl) {
+    delete []cl->literals;
+    delete cl;
+}
+
+void free_sequent(Sequent *seq) {
+    memory_release(seq->clause_category, seq->clause_bytes);
+    memory_release(MEM_HEURISTICS, seq->heuristic_bytes);
+    for (int i = 0; i < seq->n; i++)
+        free_clause(seq->clause_set[i]);
+    delete [](seq->clause_set);
+    delete seq;
+}
+
+void free_clause_set(Clause **clause_set, int n) {
+    for (int i = 0; i < n; i++)
+        free_clause(clause_set[i]);
+    delete []clause_set;
+}
+
+void free_remaining_sequents(vector<Sequent*> *stack) {
+    while ((*stack).size() > 0) {
+        Sequent *seq = (*stack).back();
+        free_sequent(seq);
+        (*stack).pop_back();
+    }
+}
+
+void print_clause_set(Clause** clause_set, int n) {
+    for (int i = 0; i < n; i++) {
+        clause_set[i]->print();
+        cout << endl;
+    }
+}
+
+/**
+ * Writes a model as a 'v' line terminated by 0.
+*/
+void print_model(const vector<literal> &model, ostream &out) {
+    out << "v ";
+    for (literal lit : model) {
+        if (!lit.positive) out << "-";
+        out << lit.var << " ";
+    }
+    out << "0" << endl;
+}
+
+/**
+ * Reads the model off a sequent on which atomic cut is no longer possible.
+ * Every variable then occurs at most once, so the first literal of each clause can be made true.
+*/
+void sequent_model(Sequent *seq, vector<literal> *model) {
+    model->clear();
+    for (int i = 0; i < seq->n; i++)
+        model->push_back(seq->clause_set[i]->literals[0]);
+}
+
+/**
+ * Searches the atomic-cut tree below a sequent, exploring the branches in the order given by the
+ * search configuration. On success the model is stored in the search context.
+ * The search gives up, freeing every sequent it still holds, once ctx->stop is set
+ * or the budget is exhausted.
+*/
+static bool cancelled(search_context *ctx) {
+    return (ctx->stop != NULL && ctx->stop->load(memory_order_relaxed)) ||
+           (ctx->budget != NULL && ctx->budget->stopped());
+}
+
+/**
+ * Writes the negation of the cuts on the path, plus one optional literal, as a proof clause.
+ * The sequent of the path is the clause set simplified by its cuts and unit propagation,
+ * so once it is refuted this clause follows by reverse unit propagation.
+*/
+static void write_path_clause(search_context *ctx, bool remove, const literal *last = NULL) {
+    vector<uint32_t> lits;
+    for (literal lit : ctx->path) lits.push_back(mk_lit(lit.var, !lit.positive));
+    if (last != NULL) lits.push_back(mk_lit(last->var, !last->positive));
+    if (remove) ctx->proof->remove(lits);
+    else ctx->proof->add(lits);
+}
+
+/**
+ * Hands the open branches of a search to its checkpoint writer: the queued cubes, the sequent at the
+ * end of the path, and the second branch of every cut on the path whose first branch is still searched.
+*/
+static void save_open_branches(search_context *ctx) {
+    checkpoint_state state;
+    state.kind = CHECKPOINT_SEQUENT;
+    if (ctx->queued != NULL) {
+        for (const vector<literal> &queued : *ctx->queued) {
+            state.cubes.emplace_back();
+            for (literal lit : queued) state.cubes.back().push_back(mk_lit(lit.var, lit.positive));
+        }
+    }
+
+    // The cube followed by the first length cuts of the path, the last of them flipped if flip_last is set
+    auto add_path = [&](size_t length, bool flip_last) {
+        state.cubes.emplace_back();
+        for (literal lit : ctx->cube) state.cubes.back().push_back(mk_lit(lit.var, lit.positive));
+        for (size_t i = 0; i < length; i++)
+            state.cubes.back().push_back(mk_lit(ctx->path[i].var, ctx->path[i].positive != (flip_last && i == length - 1)));
+    };
+    for (size_t i = 0; i < ctx->path.size(); i++)
+        if (ctx->open[i]) add_path(i + 1, true);
+    add_path(ctx->path.size(), false);
+    ctx->checkpoint->save(move(state));
+}
+
+bool prove(Sequent *seq, search_context *ctx) {
+    TRACE_SCOPE("prove");
+    if ((ctx->stop != NULL && ctx->stop->load(memory_order_relaxed)) ||
+        (ctx->budget != NULL && ctx->budget->exhausted(ctx->decisions, ctx->propagations))) {
+        // Cancelled; the first sequent to see it saves the open branches, which include itself
+        if (ctx->checkpoint != NULL) {
+            save_open_branches(ctx);
+            ctx->checkpoint = NULL;
+        }
+        free_sequent(seq);
+        return 0;
+    }
+    if (ctx->checkpoint != NULL && ctx->checkpoint->requested()) save_open_branches(ctx);
+
+    // Simplifies the sequent as much as possible
+    {
+        TRACE_SCOPE("propagate");
+        while (seq->propagate()) ctx->propagations++;
+    }
+
+    // Abandons branch if the now-simplified sequent is an axiom
+    if (seq->is_axiom()) {
+        count_conflict();
+        free_sequent(seq);
+        if (ctx->proof != NULL) write_path_clause(ctx, false);
+        return 0;
+    }
+
+    uint32_t var = choose_cut_var(seq, ctx->config, &ctx->rng);
+
+    // Sequent is satisfiable if atomic cut is impossible and sequent is not an axiom
+    if (var == 0) {
+        sequent_model(seq, &ctx->model);
+        free_sequent(seq);
+        return 1;
+    }
+
+    // Applies atomic cut, abandoning current sequent
+    Sequent *left;
+    Sequent *right;
+    apply_atomic_cut(seq, &left, &right, var);
+    free_sequent(seq);
+    ctx->decisions++;
+    note_depth(left->depth);
+
+    bool positive_first = choose_positive_first(ctx->config, &ctx->rng);
+    if (!positive_first) swap(left, right);
+
+    bool track_path = ctx->proof != NULL || ctx->checkpoint != NULL;
+    if (track_path) {
+        ctx->path.push_back({var, positive_first});
+        ctx->open.push_back(true);
+    }
+
+    if (prove(left, ctx) == 1) {
+        // Satisfiable
+        free_sequent(right);
+        return 1;
+    }
+
+    if (track_path) {
+        ctx->path.back().positive = !positive_first;
+        ctx->open.back() = false;
+    }
+
+    if (prove(right, ctx) == 1) {
+        // Satisfiable
+        return 1;
+    }
+
+    if (track_path) {
+        // Both branches are refuted: resolves their clauses on the cut variable
+        literal cut = ctx->path.back();
+        ctx->path.pop_back();
+        ctx->open.pop_back();
+        if (ctx->proof != NULL && !cancelled(ctx)) {
+            write_path_clause(ctx, false);
+            write_path_clause(ctx, true, &cut);
+            cut.positive = !cut.positive;
+            write_path_clause(ctx, true, &cut);
+        }
+    }
+
+    return 0;
+}
+
+bool prove(Sequent *seq) {
+    search_context ctx;
+    bool res = prove(seq, &ctx);
+
+    if (res == 1) {
+        cout << "s SATISFIABLE" << endl;
+        print_model(ctx.model);
+    }
+
+    return res;
+}
+
+/**
+ * Creates the root sequent of a clause set, taking ownership of the clause set.
+ * Collects the indexes of all one-literal clauses and the occurrence count of every variable.
+*/
+Sequent *create_root_sequent(Clause **clause_set, int n) {
+    Sequent *seq = new Sequent(clause_set, n);
+    occurrence_map var_count;
+
+    // Find indexes of all one-literal clauses
+    for (int i = 0; i < n; i++) {
+        if (seq->clause_set[i]->n == 1) seq->single_clause_indexes.push(i);
+        for (int j = 0; j < seq->clause_set[i]->n; j++) {
+            literal lit = seq->clause_set[i]->literals[j];
+            if (var_count.find(lit.var) != var_count.end()) {
+                // Increment count by 1
+                var_count[lit.var]++;
+            } else {
+                var_count[lit.var] = 1;
+            }
+        }
+    }
+    seq->var_count = move(var_count);
+    seq->account_memory(MEM_CLAUSES);
+
+    return seq;
+}
+
+/**
+ * Completes a model over variables 1 .. num_vars, in order, setting the variables it leaves open to false,
+ * and evaluates the flat clause set under it. Returns false, printing the first falsified clause, if it is not a model.
+*/
+bool verify_model(const CnfFormula &formula, uint32_t num_vars, vector<literal> *model) {
+    for (literal lit : *model) num_vars = max(num_vars, lit.var);
+    num_vars = max(num_vars, formula.num_vars);
+
+    // Truth value of every literal code
+    vector<char> value(2 * (num_vars + 1), 0);
+    for (literal lit : *model) {
+        if (value[mk_lit(lit.var, !lit.positive)]) {
+            cout << "c Error: the model assigns variable " << lit.var << " both ways" << endl;
+            return false;
+        }
+        value[mk_lit(lit.var, lit.positive)] = 1;
+    }
+
+    model->clear();
+    for (uint32_t v = 1; v <= num_vars; v++) {
+        if (!value[mk_lit(v, true)]) value[mk_lit(v, false)] = 1;
+        model->push_back({v, value[mk_lit(v, true)] == 1});
+    }
+
+    for (uint32_t i = 0; i < formula.num_clauses(); i++) {
+        bool satisfied = false;
+        for (uint64_t k = formula.start[i]; k < formula.start[i+1] && !satisfied; k++)
+            satisfied = value[formula.lits[k]];
+        if (!satisfied) {
+            cout << "c Error: the model falsifies clause";
+            for (uint64_t k = formula.start[i]; k < formula.start[i+1]; k++)
+                cout << " " << (lit_positive(formula.lits[k]) ? "" : "-") << lit_var(formula.lits[k]);
+            cout << endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * Completes and verifies a model with verify_model(), printing how long the check took.
+ * Returns false if it is not a model, after verify_model() has printed the falsified clause.
+*/
+bool check_model(const CnfFormula &formula, uint32_t num_vars, vector<literal> *model) {
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    bool verified = verify_model(formula, num_vars, model);
+    double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    if (verified) cout << "c Model verified against " << formula.num_clauses() << " clauses in " << seconds << " s" << endl;
+    return verified;
+}
+
+/**
+ * Writes the answer of a search: the model if one was found, 's UNKNOWN' with the reason and the
+ * statistics so far if the budget ran out, and 's UNSATISFIABLE' otherwise.
+ * Given the original clause set, a model is completed and verified against it first,
+ * and one that fails verification is reported as 's UNKNOWN'.
+ * Given var_names, the model is printed with the original ids of compacted variables.
+*/
+static void print_result(bool res, vector<literal> &model, SearchBudget *budget, const CnfFormula *original = NULL, uint32_t num_vars = 0,
+                         const vector<uint32_t> *var_names = NULL) {
+    if (res == 1 && original != NULL && !check_model(*original, var_names != NULL ? search_vars(*var_names, num_vars) : num_vars, &model)) {
+        cout << "s UNKNOWN" << endl;
+        return;
+    }
+
+    if (res == 1) {
+        cout << "s SATISFIABLE" << endl;
+        if (var_names != NULL) restore_variables(&model, *var_names, num_vars);
+        print_model(model);
+    } else if (budget->stopped()) {
+        cout << "c Stopped: " << budget->reason() << " after " << budget->elapsed() << " s" << endl;
+        cout << "c   decisions " << budget->total_decisions() << ", propagations " << budget->total_propagations() << endl;
+        if (strcmp(budget->reason(), "memory limit") == 0 || strcmp(budget->reason(), "out of memory") == 0) print_memory_report();
+        cout << "s UNKNOWN" << endl;
+    } else {
+        cout << "s UNSATISFIABLE" << endl;
+    }
+}
+
+/**
+ * Flushes and closes a proof, if any, reporting its size.
+*/
+static void close_proof(ProofWriter *proof) {
+    if (proof == NULL) return;
+    proof->flush();
+    cout << "c Proof: " << proof->lemmas << " lemmas, " << proof->deletions << " deletions, " << proof->bytes << " bytes" << endl;
+    delete proof;
+}
+
+/**
+ * Reads the checkpoint to resume, if the options name one, and creates the checkpoint writer, if they ask
+ * for one. A missing checkpoint starts the search from scratch; one that is malformed, belongs to another
+ * formula or to the other search is an error, and false is returned.
+*/
+static bool open_checkpoint(Clause **clause_set, int n, const solve_options &opts, SearchBudget *budget,
+                            checkpoint_state *resumed, bool *resuming, CheckpointWriter **checkpoint) {
+    if (opts.checkpoint_file.empty() && opts.resume_file.empty()) return true;
+    uint64_t hash = hash_clause_set(clause_set, n);
+    uint32_t kind = opts.cdcl_threads > 0 ? CHECKPOINT_CDCL : CHECKPOINT_SEQUENT;
+
+    if (!opts.resume_file.empty()) {
+        int status = read_checkpoint(opts.resume_file, resumed);
+        if (status < 0) {
+            cerr << "Error: " << opts.resume_file << " is not a checkpoint" << endl;
+            return false;
+        }
+        if (status == 0) {
+            cout << "c No checkpoint in " << opts.resume_file << ", starting from scratch" << endl;
+        } else if (resumed->formula_hash != hash) {
+            cerr << "Error: checkpoint " << opts.resume_file << " belongs to another formula" << endl;
+            return false;
+        } else if (resumed->kind != kind) {
+            cerr << "Error: checkpoint " << opts.resume_file << " was saved by the "
+                 << (resumed->kind == CHECKPOINT_CDCL ? "CDCL" : "sequent") << " search" << endl;
+            return false;
+        } else {
+            *resuming = true;
+            cout << "c Resuming " << opts.resume_file << " after " << resumed->seconds << " s, "
+                 << resumed->decisions << " decisions: ";
+            if (kind == CHECKPOINT_CDCL) cout << resumed->learnts.size() << " learnt clauses" << endl;
+            else cout << resumed->cubes.size() << " open branches" << endl;
+        }
+    }
+
+    if (!opts.checkpoint_file.empty())
+        *checkpoint = new CheckpointWriter(opts.checkpoint_file, opts.checkpoint_interval, hash, budget, *resuming ? resumed : NULL);
+    return true;
+}
+
+static void solve(Clause **clause_set, int n, const solve_options &opts, SearchBudget &budget) {
+    vector<literal> model;
+    bool res;
+
+    if (opts.enumerate) {
+        CnfFormula formula;
+        build_cnf_formula(clause_set, n, &formula);
+        free_clause_set(clause_set, n);
+
+        bool verified;
+        uint64_t count = enumerate_models(formula, opts.num_vars, opts.projection, opts.max_models, &budget, &verified);
+        if (!verified) {
+            cout << "s UNKNOWN" << endl;
+        } else if (count == 0) {
+            print_result(0, model, &budget);
+        } else {
+            if (budget.stopped()) cout << "c Stopped: " << budget.reason() << " after " << budget.elapsed() << " s" << endl;
+            cout << "s SATISFIABLE" << endl;
+        }
+        return;
+    }
+
+    if (opts.maxsat) {
+        maxsat_solve(clause_set, n, opts.weights, opts.num_vars, &budget);
+        return;
+    }
+
+    if (opts.core) {
+        extract_core(clause_set, n, opts.num_vars, opts.minimize_core, &budget);
+        return;
+    }
+
+    if (opts.backbone) {
+        CnfFormula formula;
+        build_cnf_formula(clause_set, n, &formula);
+        free_clause_set(clause_set, n);
+        compute_backbone(formula, opts.num_vars, opts.backbone_chunk, &budget);
+        return;
+    }
+
+    if (opts.count) {
+        BigInt count;
+        if (count_models(clause_set, n, opts.num_vars, opts.count_cache_mb, &budget, &count)) {
+            cout << (count.is_zero() ? "s UNSATISFIABLE" : "s SATISFIABLE") << endl;
+            cout << "c s exact arb int " << count.to_string() << endl;
+        } else {
+            print_result(0, model, &budget);
+        }
+        return;
+    }
+
+    if (!opts.check_proof_file.empty()) {
+        check_proof(clause_set, n, opts.check_proof_file, opts.lrat_file);
+        free_clause_set(clause_set, n);
+        return;
+    }
+
+    ProofWriter *proof = NULL;
+    if (!opts.proof_file.empty()) {
+        proof = new ProofWriter(opts.proof_file, opts.proof_binary);
+        if (!proof->is_open()) {
+            delete proof;
+            free_clause_set(clause_set, n);
+            return;
+        }
+    }
+
+    checkpoint_state resumed;
+    bool resuming = false;
+    CheckpointWriter *checkpoint = NULL;
+    if (!open_checkpoint(clause_set, n, opts, &budget, &resumed, &resuming, &checkpoint)) {
+        free_clause_set(clause_set, n);
+        return;
+    }
+
+    CnfFormula original;
+    res = decide(clause_set, n, opts, &budget, proof, &original, &model, NULL, checkpoint, resuming ? &resumed : NULL);
+    close_proof(proof);
+    if (checkpoint != NULL) {
+        // An answer makes the checkpoint useless
+        if (res == 1 || !budget.stopped()) checkpoint->discard();
+        else cout << "c Checkpoint saved to " << opts.checkpoint_file << endl;
+        delete checkpoint;
+    }
+    print_result(res, model, &budget, &original, opts.num_vars, &opts.var_names);
+}
+
+/**
+ * Determines the satisfiability of a clause set within the limits of the options.
+ * Writes 's SATISIFABLE' followed by solution, 's UNSATISFIABLE' or 's UNKNOWN' to stdout.
+ * Running out of memory in the calling thread also ends with 's UNKNOWN', leaking what the search held.
+*/
+void solve(Clause **clause_set, int n, const solve_options &opts) {
+    SearchBudget budget(opts.limits);
+    ProgressReporter reporter(&budget, opts.progress_interval, opts.stats);
+    try {
+        solve(clause_set, n, opts, budget);
+    } catch (bad_alloc &) {
+        cout << "c Stopped: out of memory after " << budget.elapsed() << " s" << endl;
+        print_memory_report();
+        cout << "s UNKNOWN" << endl;
+    }
+}
+
+/**
+ * Searches the open branches of a checkpoint one after the other, or the whole tree if resumed is NULL,
+ * saving the branches still open to the checkpoint writer, if any, when it asks and when the search is stopped.
+ * Takes ownership of the root sequent.
+*/
+static bool prove_open_branches(Sequent *root, const checkpoint_state *resumed, CheckpointWriter *checkpoint,
+                                SearchBudget *budget, vector<literal> *model) {
+    vector<vector<literal>> queued;
+    if (resumed == NULL) {
+        queued.emplace_back();
+    } else {
+        for (const vector<uint32_t> &cube : resumed->cubes) {
+            queued.emplace_back();
+            for (uint32_t lit : cube) queued.back().push_back({lit_var(lit), lit_positive(lit)});
+        }
+    }
+
+    search_context ctx;
+    ctx.budget = budget;
+    ctx.checkpoint = checkpoint;
+    ctx.queued = &queued;
+    bool res = 0;
+    // Last in first out, which continues the depth-first order of the saved search
+    while (!queued.empty() && res == 0 && !budget->stopped()) {
+        ctx.cube = queued.back();
+        queued.pop_back();
+        ctx.path.clear();
+        ctx.open.clear();
+        res = prove(build_cube_sequent(root, ctx.cube), &ctx);
+    }
+
+    free_sequent(root);
+    budget->add_work(ctx.decisions, ctx.propagations);
+    *model = ctx.model;
+    return res;
+}
+
+/**
+ * Decides a clause set with the search selected by the options, taking ownership of the clause set.
+ * original receives the flat copy of the clause set, which the search simplifies in place, to verify
+ * the model with. A result of 0 means unsatisfiable, unless the budget was stopped.
+ * If preprocess_seconds is given, it receives the time spent before the search: copying and classifying
+ * the clause set, but not deciding it in linear time when it falls in an easy class.
+ * The single-threaded sequent and CDCL searches save their state to checkpoint, and continue the one in resumed.
+*/
+bool decide(Clause **clause_set, int n, const solve_options &opts, SearchBudget *budget, ProofWriter *proof,
+            CnfFormula *original, vector<literal> *model, double *preprocess_seconds,
+            CheckpointWriter *checkpoint, const checkpoint_state *resumed) {
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    bool res;
+
+    build_cnf_formula(clause_set, n, original);
+    chrono::steady_clock::time_point copied = chrono::steady_clock::now();
+
+    // 2-SAT and (renamable) Horn formulas are decided in linear time, without a proof
+    bool fast = proof == NULL && solve_fast_path(clause_set, n, &res, model);
+    if (preprocess_seconds != NULL)
+        *preprocess_seconds = chrono::duration<double>((fast ? copied : chrono::steady_clock::now()) - start).count();
+    if (fast) return res;
+
+    if (opts.cdcl_threads > 0) {
+        free_clause_set(clause_set, n);
+        return cdcl_solve(*original, opts.cdcl_threads, opts.seed, budget, model, proof, checkpoint, resumed) == CDCL_SAT;
+    }
+
+    Sequent *seq = create_root_sequent(clause_set, n);
+
+    if (opts.cube_count > 0) {
+        cube_options cube_opts;
+        cube_opts.max_cubes = opts.cube_count;
+        cube_opts.max_depth = opts.cube_depth;
+        cube_opts.icnf_file = opts.icnf_file;
+        res = prove_cubes(seq, cube_opts, opts.num_threads, budget, model);
+    } else if (opts.portfolio_size > 1) {
+        res = prove_portfolio(seq, opts.portfolio_size, opts.seed, budget, model);
+    } else if (opts.num_threads > 1) {
+        res = prove_parallel(seq, opts.num_threads, budget, model);
+    } else if (checkpoint != NULL || resumed != NULL) {
+        res = prove_open_branches(seq, resumed, checkpoint, budget, model);
+    } else {
+        search_context ctx;
+        ctx.budget = budget;
+        ctx.proof = proof;
+        res = prove(seq, &ctx);
+        budget->add_work(ctx.decisions, ctx.propagations);
+        *model = ctx.model;
+    }
+    return res;
+}
+
+/**
+ * Renumbers the variables of a clause set to 1 .. V in increasing order of their ids, if fewer than half of
+ * the ids up to the largest one occur, so that the arrays the searches index by variable stay small.
+ * var_names receives the original id of every variable, at its new index, or is left empty.
+*/
+static void compact_variables(Clause **clause_set, int n, vector<uint32_t> *var_names) {
+    uint32_t max_var = 0;
+    uint64_t num_literals = 0;
+    for (int i = 0; i < n; i++) {
+        for (int j = 0; j < clause_set[i]->n; j++) max_var = max(max_var, clause_set[i]->literals[j].var);
+        num_literals += clause_set[i]->n;
+    }
+
+    // The ids that occur in increasing order, found with a bit per id unless the ids are much sparser than the literals
+    vector<uint32_t> vars;
+    if (max_var / 32 <= num_literals) {
+        vector<bool> seen(max_var + 1, false);
+        for (int i = 0; i < n; i++)
+            for (int j = 0; j < clause_set[i]->n; j++) seen[clause_set[i]->literals[j].var] = true;
+        for (uint32_t v = 1; v <= max_var; v++)
+            if (seen[v]) vars.push_back(v);
+    } else {
+        vars.reserve(num_literals);
+        for (int i = 0; i < n; i++)
+            for (int j = 0; j < clause_set[i]->n; j++) vars.push_back(clause_set[i]->literals[j].var);
+        sort(vars.begin(), vars.end());
+        vars.erase(unique(vars.begin(), vars.end()), vars.end());
+    }
+
+    var_names->clear();
+    if (vars.size() * 2 >= max_var) return;
+
+    var_names->push_back(0);
+    var_names->insert(var_names->end(), vars.begin(), vars.end());
+    for (int i = 0; i < n; i++) {
+        for (int j = 0; j < clause_set[i]->n; j++) {
+            literal &lit = clause_set[i]->literals[j];
+            lit.var = lower_bound(var_names->begin() + 1, var_names->end(), lit.var) - var_names->begin();
+        }
+    }
+}
+
+/**
+ * Gives the variables of a model renumbered by compact_variables() their original ids, and completes it
+ * over the declared variables 1 .. num_vars, setting the ids in no clause to false.
+ * The model must be in variable order, as verify_model() leaves it.
+*/
+void restore_variables(vector<literal> *model, const vector<uint32_t> &var_names, uint32_t num_vars) {
+    if (var_names.empty()) return;
+    vector<literal> compacted;
+    compacted.swap(*model);
+    num_vars = max(num_vars, var_names.back());
+    model->reserve(num_vars);
+    size_t next = 0;
+    for (uint32_t v = 1; v <= num_vars; v++) {
+        while (next < compacted.size() && var_names[compacted[next].var] < v) next++;
+        bool positive = next < compacted.size() && var_names[compacted[next].var] == v && compacted[next].positive;
+        model->push_back({v, positive});
+    }
+}
+
+/**
+ * Number of variables a search works with: the declared ones, or those left by compact_variables().
+*/
+uint32_t search_vars(const vector<uint32_t> &var_names, uint32_t num_vars) {
+    return var_names.empty() ? num_vars : var_names.size() - 1;
+}
+
+/**
+ * Reads a formula in CNF from file.
+ * Functions for parsing of cnf files authored by John Burkardt.
+ * Returns formula as a clause set, and the number of variables declared in the header if num_vars is given.
+ * Literals are counted in 64 bits, so a file may hold more than 2^31 of them; clauses are at most INT_MAX.
+ * If var_names is given, sparse variable ids are compacted, see compact_variables(); num_vars stays the
+ * declared number, which restore_variables() completes the model over.
+ * Returns NULL if the file cannot be opened or is malformed.
+*/
+Clause** read_cnf_file(string filename, int *n, uint32_t *num_vars, vector<uint32_t> *var_names) {
+    TRACE_SCOPE("read_cnf_file");
+    int v_num;
+    long long c_num, l_num;
+    *n = 0;
+    try {
+        cnf_header_read(filename, &v_num, &c_num, &l_num);
+    } catch (const runtime_error &e) {
+        return NULL;
+    }
+    if (c_num < 0 || c_num > INT_MAX) return NULL;
+    if (num_vars != NULL) *num_vars = v_num;
+
+    int *l_c_num = new int[c_num+1];
+    int *l_val = new int[l_num];
+    try {
+        cnf_data_read(filename, v_num, c_num, l_num, l_c_num, l_val);
+    } catch (const runtime_error &e) {
+        delete []l_c_num;
+        delete []l_val;
+        return NULL;
+    }
+
+    Clause **clause_set = new Clause*[c_num];
+    int c_num2 = 0;
+    long long l_num2 = 0;
+
+    while (1) {
+        if (c_num2 == c_num) break;
+
+        int num_literals = l_c_num[c_num2];
+        literal* literals = new literal[num_literals];
+
+        for (int i = 0; i < num_literals; i++) {
+            int var = l_val[l_num2];
+            bool positive = var > 0;
+            literal lit = {(uint32_t) abs(var), positive};
+            literals[i] = lit;
+            l_num2++;
+        }
+
+        Clause *cl = new Clause(literals, num_literals);
+        clause_set[c_num2] = cl;
+        c_num2++;
+    }
+
+    *n = c_num;
+    delete []l_c_num;
+    delete []l_val;
+
+    if (var_names != NULL) compact_variables(clause_set, *n, var_names);
+    return clause_set;
+}
+
+/**
+ * Reads a weighted formula in WCNF from file, in the classic format with a 'p wcnf' header
+ * or in the newer format marking hard clauses with 'h'.
+ * Returns the clauses as a clause set, with the weight of each one (0 for hard clauses) in weights,
+ * or NULL if the file cannot be opened or is malformed.
+*/
+Clause** read_wcnf_file(string filename, int *n, vector<uint64_t> *weights, uint32_t *num_vars) {
+    int v_num;
+    long long c_num, l_num;
+    *n = 0;
+    try {
+        wcnf_header_read(filename, &v_num, &c_num, &l_num);
+    } catch (const runtime_error &e) {
+        return NULL;
+    }
+    if (c_num > INT_MAX) return NULL;
+    if (num_vars != NULL) *num_vars = v_num;
+
+    int *l_c_num = new int[c_num+1];
+    int *l_val = new int[l_num+1];
+    long long *c_weight = new long long[c_num+1];
+    try {
+        wcnf_data_read(filename, v_num, c_num, l_num, l_c_num, l_val, c_weight);
+    } catch (const runtime_error &e) {
+        delete []l_c_num;
+        delete []l_val;
+        delete []c_weight;
+        return NULL;
+    }
+
+    Clause **clause_set = new Clause*[c_num];
+    weights->assign(c_num, 0);
+    long long l_num2 = 0;
+
+    for (int i = 0; i < c_num; i++) {
+        literal* literals = new literal[l_c_num[i]];
+        for (int j = 0; j < l_c_num[i]; j++) {
+            int var = l_val[l_num2++];
+            literals[j] = {(uint32_t) abs(var), var > 0};
+        }
+        clause_set[i] = new Clause(literals, l_c_num[i]);
+        (*weights)[i] = c_weight[i];
+    }
+
+    *n = c_num;
+    delete []l_c_num;
+    delete []l_val;
+    delete []c_weight;
+
+    return clause_set;
+}
+
+/**
+ * Builds a full clause set from the given variables.
+ * The full clause set will be unsatisfiable.
+ * n variables -> 2^n clauses.
+*/
+Clause** build_full_clause_set(int num_vars) {
+    Clause **clause_set = new Clause*[1 << num_vars];
+
+    for (int i = 0; i < (1 << num_vars); i++) {
+        literal* literals = new literal[num_vars];
+        for (uint32_t j = 0; j < (uint32_t) num_vars; j++) {
+            // Variable j+1 is negated where bit num_vars-1-j of the clause index is set
+            bool positive = ((i >> (num_vars - 1 - j)) & 1) == 0;
+            literal lit = {j+1, positive};
+            literals[j] = lit;
+        }
+        Clause *cl = new Clause(literals, num_vars);
+        clause_set[i] = cl;
+    }
+
+    return clause_set;
+}
+
+/** 20sek
+ * Tests two formulae in CNF with n variables.
+ * The first formula proven is a full clause set of 2^n clauses (unsatisfiable).
+ * The second formula is an almost full clause set of 2^n-1 clauses (satisfiable).
+*/
+void test(int num_variables) {
+    int num_clauses = 1 << num_variables;
+    cout << "c Testing sequent with " << num_variables << " variables (" << num_clauses << " clauses)" << endl;
+
+    cout << "c Unsatisfiable test:" << endl;
+    Clause** cl1 = build_full_clause_set(num_variables);
+    solve(cl1, num_clauses);
+    
+    cout << "c Satisfiable test:" << endl;
+    Clause** cl2 = build_full_clause_set(num_variables);
+    free_clause(cl2[num_clauses-1]);
+    solve(cl2, num_clauses-1);
+}
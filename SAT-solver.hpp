@@ -1,44 +1,187 @@
-#ifndef SAT_SOLVER_H
-#define SAT_SOLVER_H
-
-#include <iostream>
-#include <vector>
-#include <string>
-#include <cstring>
-#include <cmath>
-#include <queue>
-#include <fstream>
-#include <sstream>
-#include <map>
-using namespace std;
-
-struct literal {
-    uint32_t var;
-    bool positive;
-};
-
-class Clause;
-class Sequent;
-
-void free_clause(Clause *cl);
-void free_sequent(Sequent *seq);
-void free_remaining_sequents(vector<Sequent*> *stack);
-
-void print_clause_set(Clause** clause_set, int n);
-
-Clause* deep_cp_clause(Clause* cl, uint32_t ignore_var);
-
-uint32_t choose_cut_var(Sequent *seq);
-Sequent *atomic_cut_create_sequent(Clause **clause_set, int n, uint32_t var, bool val);
-void apply_atomic_cut(Sequent *seq, Sequent **left, Sequent **right, uint32_t var);
-
-Clause** build_full_clause_set(int num_vars);
-
-Clause** read_cnf_file(string filename, int *n);
-
-void test(int num_variables);
-
-bool prove(Sequent *seq);
-void solve(Clause **clause_set, int n);
-
+#ifndef SAT_SOLVER_H
+#define SAT_SOLVER_H
+
+#include <iostream>
+#include <vector>
+#include <string>
+#include <cstring>
+#include <cmath>
+#include <queue>
+#include <fstream>
+#include <sstream>
+#include <map>
+#include <atomic>
+#include <stdexcept>
+#include "limits.hpp"
+#include "memory.hpp"
+#include "pool.hpp"
+using namespace std;
+
+class ProofWriter;
+class CheckpointWriter;
+struct checkpoint_state;
+struct CnfFormula;
+
+struct literal {
+    uint32_t var;
+    bool positive;
+    // Literal arrays come from the pool; the sized delete makes the array remember its size
+    static void *operator new[](size_t size) { return pool_alloc(size); }
+    static void operator delete[](void *p, size_t size) { pool_free(p, size); }
+};
+
+struct solve_options {
+    int num_threads = 1;
+    int portfolio_size = 1;
+    int cdcl_threads = 0;
+    int cube_count = 0;
+    int cube_depth = 32;
+    string icnf_file;
+    uint32_t seed = 0;
+    solve_limits limits;
+    // Enumerates models instead of stopping at the first one, at most max_models unless 0
+    bool enumerate = false;
+    uint64_t max_models = 0;
+    // Variables the enumerated models are projected onto, all variables if empty
+    vector<uint32_t> projection;
+    // Counts the models exactly, with a component cache of at most count_cache_mb MB
+    bool count = false;
+    uint64_t count_cache_mb = 256;
+    // Variables declared by the input; models are counted over 1 .. num_vars
+    uint32_t num_vars = 0;
+    // Original ids of the variables if the input was read with compacted ids, see read_cnf_file()
+    vector<uint32_t> var_names;
+    // Prints an unsatisfiable subset of the clauses, minimized with minimize_core
+    bool core = false;
+    bool minimize_core = false;
+    // Prints the literals true in every model, testing backbone_chunk candidates per solver call
+    bool backbone = false;
+    int backbone_chunk = 16;
+    // Weighted partial MaxSAT: weights of the clauses, 0 for hard clauses
+    bool maxsat = false;
+    vector<uint64_t> weights;
+    // Writes a DRAT proof of unsatisfiability, binary unless proof_binary is false
+    string proof_file;
+    bool proof_binary = true;
+    // Checks the DRAT proof in check_proof_file instead of solving, writing it as LRAT to lrat_file if given
+    string check_proof_file;
+    string lrat_file;
+    // Prints a progress line every progress_interval seconds if positive, and a summary at the end if stats is set
+    double progress_interval = 0;
+    bool stats = false;
+    // Saves the state of the search to checkpoint_file every checkpoint_interval seconds and when it is stopped,
+    // and continues the search saved in resume_file
+    string checkpoint_file;
+    double checkpoint_interval = 60;
+    string resume_file;
+};
+
+enum cut_heuristic {
+    CUT_MOST_OCCURRENCES,
+    CUT_MOST_OCCURRENCES_RANDOM_TIES,
+    CUT_WEIGHTED_RANDOM
+};
+
+enum cut_polarity {
+    POLARITY_POSITIVE,
+    POLARITY_NEGATIVE,
+    POLARITY_RANDOM
+};
+
+struct search_config {
+    cut_heuristic heuristic = CUT_MOST_OCCURRENCES;
+    cut_polarity polarity = POLARITY_POSITIVE;
+};
+
+struct search_context {
+    search_config config;
+    uint32_t rng = 2463534242u;
+    // Set by another thread to cancel the search
+    atomic<bool> *stop = NULL;
+    SearchBudget *budget = NULL;
+    uint64_t decisions = 0;
+    uint64_t propagations = 0;
+    vector<literal> model;
+    // Receives the refuted branches as DRAT lemmas; path holds the cuts leading to the current sequent
+    ProofWriter *proof = NULL;
+    vector<literal> path;
+    // Saves the open branches when asked: those of the search below cube, which is
+    // followed by the path, and the cubes still queued after it
+    CheckpointWriter *checkpoint = NULL;
+    vector<literal> cube;
+    const vector<vector<literal>> *queued = NULL;
+    // For each cut on the path, whether its second branch is still to be searched
+    vector<bool> open;
+};
+
+class Clause {
+    public:
+        literal *literals;
+        int n;
+        Clause(literal *literals, int n);
+        int can_be_simplified_with(literal lit, literal *lit_out);
+        void print();
+        static void *operator new(size_t size) { return pool_alloc(size); }
+        static void operator delete(void *p, size_t size) { pool_free(p, size); }
+};
+
+// Occurrence counts of the variables of a sequent, with the nodes in the pool
+typedef map<uint32_t, int, less<uint32_t>, PoolAllocator<pair<const uint32_t, int>>> occurrence_map;
+
+class Sequent {
+    public:
+        Clause **clause_set;
+        int n;
+        queue<int> single_clause_indexes;
+        occurrence_map var_count;
+        // Number of cuts above the sequent in the search tree
+        int depth = 0;
+        // Bytes added to the memory accounting, released by free_sequent
+        memory_category clause_category = MEM_CLAUSES;
+        uint64_t clause_bytes = 0;
+        uint64_t heuristic_bytes = 0;
+        Sequent(Clause **clause_set, int n);
+        bool is_axiom();
+        bool propagate();
+        void account_memory(memory_category category);
+        static void *operator new(size_t size) { return pool_alloc(size); }
+        static void operator delete(void *p, size_t size) { pool_free(p, size); }
+};
+
+void free_clause(Clause *cl);
+void free_sequent(Sequent *seq);
+void free_clause_set(Clause **clause_set, int n);
+void free_remaining_sequents(vector<Sequent*> *stack);
+
+void print_clause_set(Clause** clause_set, int n);
+void print_model(const vector<literal> &model, ostream &out = cout);
+void restore_variables(vector<literal> *model, const vector<uint32_t> &var_names, uint32_t num_vars);
+uint32_t search_vars(const vector<uint32_t> &var_names, uint32_t num_vars);
+
+Clause* deep_cp_clause(Clause* cl, uint32_t ignore_var);
+
+uint32_t choose_cut_var(Sequent *seq);
+uint32_t choose_cut_var(Sequent *seq, const search_config &config, uint32_t *rng);
+bool choose_positive_first(const search_config &config, uint32_t *rng);
+Sequent *atomic_cut_create_sequent(Clause **clause_set, int n, uint32_t var, bool val);
+void apply_atomic_cut(Sequent *seq, Sequent **left, Sequent **right, uint32_t var);
+
+Clause** build_full_clause_set(int num_vars);
+
+Clause** read_cnf_file(string filename, int *n, uint32_t *num_vars = NULL, vector<uint32_t> *var_names = NULL);
+Clause** read_wcnf_file(string filename, int *n, vector<uint64_t> *weights, uint32_t *num_vars = NULL);
+
+void test(int num_variables);
+
+void sequent_model(Sequent *seq, vector<literal> *model);
+Sequent *create_root_sequent(Clause **clause_set, int n);
+bool prove(Sequent *seq, search_context *ctx);
+bool prove(Sequent *seq);
+void solve(Clause **clause_set, int n, const solve_options &opts = solve_options());
+bool decide(Clause **clause_set, int n, const solve_options &opts, SearchBudget *budget, ProofWriter *proof,
+            CnfFormula *original, vector<literal> *model, double *preprocess_seconds = NULL,
+            CheckpointWriter *checkpoint = NULL, const checkpoint_state *resumed = NULL);
+bool verify_model(const CnfFormula &formula, uint32_t num_vars, vector<literal> *model);
+bool check_model(const CnfFormula &formula, uint32_t num_vars, vector<literal> *model);
+
 #endif
\ No newline at end of file
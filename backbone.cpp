@@ -0,0 +1,106 @@
+#include <algorithm>
+#include "backbone.hpp"
+
+BackboneSolver::BackboneSolver(const CnfFormula *formula, uint32_t num_vars, SearchBudget *budget) : solver(formula) {
+    this->num_vars = max(num_vars, formula->num_vars);
+    next_activation = this->num_vars + 1;
+    solver.ensure_vars(this->num_vars);
+    solver.budget = budget;
+    this->budget = budget;
+}
+
+/**
+ * Drops the candidates falsified by the last model.
+*/
+void BackboneSolver::filter_candidates() {
+    size_t k = 0;
+    for (uint32_t lit : candidates)
+        if (solver.model_value(lit_var(lit)) == lit_positive(lit)) candidates[k++] = lit;
+    candidates.resize(k);
+}
+
+/**
+ * Writes the backbone literals, in increasing variable order, to backbone. Chunks of chunk_size
+ * candidates are tested together; a chunk of one is tested by assuming the negated literal.
+ * Returns CDCL_UNKNOWN if the budget ran out, leaving the literals proven so far in backbone.
+*/
+int BackboneSolver::compute(int chunk_size, vector<literal> *backbone) {
+    backbone->clear();
+
+    calls++;
+    int res = solver.solve();
+    budget->add_work(solver.call_decisions(), solver.call_propagations());
+    if (res != CDCL_SAT) return res;
+
+    candidates.clear();
+    for (uint32_t v = 1; v <= num_vars; v++) candidates.push_back(mk_lit(v, solver.model_value(v)));
+
+    vector<uint32_t> proven;
+    while (!candidates.empty()) {
+        size_t k = min(candidates.size(), (size_t)chunk_size);
+        vector<uint32_t> chunk(candidates.end() - k, candidates.end());
+
+        vector<uint32_t> assumptions;
+        uint32_t activation = 0;
+        if (k == 1) {
+            assumptions.push_back(chunk[0] ^ 1);
+        } else {
+            // Some literal of the chunk is false, enabled by the activation literal
+            activation = mk_lit(next_activation++, true);
+            vector<uint32_t> clause;
+            for (uint32_t lit : chunk) clause.push_back(lit ^ 1);
+            clause.push_back(activation ^ 1);
+            solver.add_clause(clause);
+            assumptions.push_back(activation);
+        }
+
+        calls++;
+        res = solver.solve(assumptions);
+        budget->add_work(solver.call_decisions(), solver.call_propagations());
+        if (activation != 0) solver.add_clause(vector<uint32_t>(1, activation ^ 1));
+        if (res == CDCL_UNKNOWN) break;
+
+        if (res == CDCL_SAT) {
+            filter_candidates();
+            continue;
+        }
+
+        // No model falsifies the chunk, its literals are fixed for all later calls
+        candidates.resize(candidates.size() - k);
+        for (uint32_t lit : chunk) {
+            solver.add_clause(vector<uint32_t>(1, lit));
+            proven.push_back(lit);
+        }
+    }
+
+    sort(proven.begin(), proven.end());
+    for (uint32_t lit : proven) backbone->push_back({lit_var(lit), lit_positive(lit)});
+    return res == CDCL_UNKNOWN ? CDCL_UNKNOWN : CDCL_SAT;
+}
+
+/**
+ * Decides a formula and, if it is satisfiable, prints its backbone over the variables 1 .. num_vars
+ * as a 'v' line. Variables in no clause are never part of the backbone.
+*/
+int compute_backbone(const CnfFormula &formula, uint32_t num_vars, int chunk_size, SearchBudget *budget) {
+    BackboneSolver backbone_solver(&formula, num_vars, budget);
+    vector<literal> backbone;
+    int res = backbone_solver.compute(chunk_size, &backbone);
+
+    if (res == CDCL_UNSAT) {
+        cout << "s UNSATISFIABLE" << endl;
+        return res;
+    }
+    if (res == CDCL_UNKNOWN) {
+        cout << "c Stopped: " << budget->reason() << " after " << budget->elapsed() << " s, "
+             << backbone.size() << " backbone literals proven" << endl;
+        cout << "s UNKNOWN" << endl;
+        return res;
+    }
+
+    cout << "c Backbone: " << backbone.size() << " of " << max(num_vars, formula.num_vars) << " variables, "
+         << backbone_solver.calls << " solver calls" << endl;
+    cout << "s SATISFIABLE" << endl;
+    print_model(backbone);
+    return res;
+}
@@ -0,0 +1,30 @@
+#ifndef BACKBONE_H
+#define BACKBONE_H
+
+#include "SAT-solver.hpp"
+#include "cdcl.hpp"
+
+/**
+ * Computes the backbone of a formula, the literals true in every model, with one incremental solver.
+ * Candidates start as the literals of a first model and are tested in chunks: a chunk is refuted
+ * under an activation literal for the clause saying one of its literals is false. Unsatisfiability
+ * proves the whole chunk, a model removes every candidate it falsifies.
+*/
+class BackboneSolver {
+    public:
+        BackboneSolver(const CnfFormula *formula, uint32_t num_vars, SearchBudget *budget);
+        int compute(int chunk_size, vector<literal> *backbone);
+        uint64_t calls = 0;
+    private:
+        CdclSolver solver;
+        SearchBudget *budget;
+        uint32_t num_vars;
+        uint32_t next_activation;
+        vector<uint32_t> candidates;
+
+        void filter_candidates();
+};
+
+int compute_backbone(const CnfFormula &formula, uint32_t num_vars, int chunk_size, SearchBudget *budget);
+
+#endif
@@ -0,0 +1,161 @@
+#include <algorithm>
+#include <thread>
+#include <mutex>
+#include <sys/stat.h>
+#include "batch.hpp"
+#include "benchmark.hpp"
+#include "cdcl.hpp"
+
+/**
+ * A file of the batch and, once solved, the lines reporting it.
+*/
+struct batch_job {
+    string path;
+    long long size = 0;
+    string status;
+    string output;
+    bool done = false;
+};
+
+/**
+ * Reads and decides one file within its own budget, writing its result to job->output:
+ * a "c File" line with the time taken, then the 's' line and, if satisfiable, the model.
+*/
+static void run_job(batch_job *job, const solve_options &opts) {
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    ostringstream out;
+
+    int n;
+    uint32_t num_vars = 0;
+    vector<uint32_t> var_names;
+    Clause **clause_set = read_cnf_file(job->path, &n, &num_vars, &var_names);
+    if (clause_set == NULL) {
+        job->status = "ERROR";
+        out << "c File " << job->path << ": cannot read" << endl;
+        out << "s UNKNOWN" << endl;
+        job->output = out.str();
+        return;
+    }
+
+    SearchBudget budget(opts.limits);
+    CnfFormula original;
+    vector<literal> model;
+    ostringstream result;
+    try {
+        bool res = decide(clause_set, n, opts, &budget, NULL, &original, &model);
+        if (res == 1 && !verify_model(original, search_vars(var_names, num_vars), &model)) {
+            job->status = "ERROR";
+            result << "c Error: the model does not satisfy the formula" << endl;
+            result << "s UNKNOWN" << endl;
+        } else if (res == 1) {
+            job->status = "SAT";
+            result << "s SATISFIABLE" << endl;
+            restore_variables(&model, var_names, num_vars);
+            print_model(model, result);
+        } else if (budget.stopped()) {
+            job->status = "UNKNOWN";
+            result << "c Stopped: " << budget.reason() << endl;
+            result << "s UNKNOWN" << endl;
+        } else {
+            job->status = "UNSAT";
+            result << "s UNSATISFIABLE" << endl;
+        }
+    } catch (const bad_alloc &e) {
+        job->status = "UNKNOWN";
+        result << "c Stopped: out of memory" << endl;
+        result << "s UNKNOWN" << endl;
+    }
+
+    double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    out << "c File " << job->path << ": " << seconds << " s" << endl;
+    job->output = out.str() + result.str();
+}
+
+/**
+ * Solves many CNF files in one process, on a pool of worker threads that each decide one file at a time
+ * with the search selected by the options and its own limits.
+ * The largest files are started first, so that a long job does not begin last and hold up the end of the
+ * batch while the other workers sit idle. The results are printed in the order of the input, each as soon
+ * as the jobs before it are done, or in the order the jobs complete.
+ * Returns 1 if a file could not be read or a list is malformed.
+*/
+int run_batch(const batch_options &batch, solve_options opts) {
+    vector<batch_job> jobs;
+    for (const string &file : batch.files) {
+        batch_job job;
+        job.path = file;
+        jobs.push_back(job);
+    }
+    if (!batch.list_file.empty()) {
+        vector<bench_instance> instances;
+        if (!read_bench_instances(batch.list_file, &instances)) return 1;
+        for (const bench_instance &instance : instances) {
+            if (!instance.generator.family.empty()) {
+                cerr << "Error: batch lists take file paths only, not generator lines" << endl;
+                return 1;
+            }
+            batch_job job;
+            job.path = instance.path;
+            jobs.push_back(job);
+        }
+    }
+
+    // Longest job first, with the size of the file standing in for the time it takes
+    vector<size_t> schedule(jobs.size());
+    for (size_t i = 0; i < jobs.size(); i++) {
+        struct stat info;
+        if (stat(jobs[i].path.c_str(), &info) == 0) jobs[i].size = info.st_size;
+        schedule[i] = i;
+    }
+    stable_sort(schedule.begin(), schedule.end(), [&](size_t a, size_t b) { return jobs[a].size > jobs[b].size; });
+
+    int num_workers = min((size_t)batch.num_workers, max(jobs.size(), (size_t)1));
+    cout << "c Batch: " << jobs.size() << " files on " << num_workers << " threads" << endl;
+
+    // The searches write to cout from every worker; only the results are printed, through the saved buffer
+    NullBuffer null_buffer;
+    streambuf *saved = cout.rdbuf(&null_buffer);
+    ostream results(saved);
+
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    atomic<size_t> next_job{0};
+    mutex output_lock;
+    size_t next_output = 0;
+    auto worker = [&]() {
+        for (;;) {
+            size_t index = next_job.fetch_add(1);
+            if (index >= schedule.size()) return;
+            batch_job &job = jobs[schedule[index]];
+            run_job(&job, opts);
+
+            lock_guard<mutex> guard(output_lock);
+            job.done = true;
+            if (batch.completion_order) {
+                results << job.output << flush;
+                continue;
+            }
+            while (next_output < jobs.size() && jobs[next_output].done) {
+                results << jobs[next_output].output;
+                jobs[next_output].output.clear();
+                next_output++;
+            }
+            results << flush;
+        }
+    };
+    vector<thread> workers;
+    for (int i = 0; i < num_workers; i++) workers.emplace_back(worker);
+    for (thread &t : workers) t.join();
+    cout.rdbuf(saved);
+
+    int sat = 0, unsat = 0, unknown = 0, errors = 0;
+    for (const batch_job &job : jobs) {
+        sat += job.status == "SAT";
+        unsat += job.status == "UNSAT";
+        unknown += job.status == "UNKNOWN";
+        errors += job.status == "ERROR";
+    }
+    double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    cout << "c Batch done: " << sat << " SAT, " << unsat << " UNSAT, " << unknown << " unknown, " << errors
+         << " errors in " << seconds << " s" << endl;
+    return errors > 0 ? 1 : 0;
+}
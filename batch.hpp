@@ -0,0 +1,19 @@
+#ifndef BATCH_H
+#define BATCH_H
+
+#include "SAT-solver.hpp"
+
+struct batch_options {
+    // CNF files given on the command line
+    vector<string> files;
+    // Directory of .cnf files or list file, read like a benchmark manifest
+    string list_file;
+    // Jobs solved at once
+    int num_workers = 1;
+    // Prints the results as the jobs complete rather than in the order of the input
+    bool completion_order = false;
+};
+
+int run_batch(const batch_options &batch, solve_options opts);
+
+#endif
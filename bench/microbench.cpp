@@ -0,0 +1,209 @@
+// Microbenchmarks of the kernels of the sequent search and of the DIMACS reader,
+// over random k-SAT clause sets of controlled size and clause length.
+// Usage: bench/microbench [kernel name filter]
+
+#include <functional>
+#include <new>
+#include <unistd.h>
+#include "SAT-solver.hpp"
+#include "generate.hpp"
+
+// Heap allocations and bytes since the start, counted by the replaced operator new. The pooled
+// objects of the search reach malloc directly on a miss of their free list; those are added from
+// the pool statistics.
+static uint64_t allocations = 0;
+static uint64_t allocated_bytes = 0;
+
+void *operator new(size_t size) {
+    allocations++;
+    allocated_bytes += size;
+    void *p = malloc(size == 0 ? 1 : size);
+    if (p == NULL) throw bad_alloc();
+    return p;
+}
+
+void operator delete(void *p) noexcept {
+    free(p);
+}
+
+void operator delete(void *p, size_t) noexcept {
+    free(p);
+}
+
+/**
+ * Random k-SAT clause set with a fixed seed.
+*/
+struct shape {
+    string name;
+    int num_vars;
+    int k;
+    double ratio;
+};
+
+static const shape SHAPES[] = {
+    {"3-SAT n=200", 200, 3, 4.26},
+    {"3-SAT n=2000", 2000, 3, 4.26},
+    {"7-SAT n=200", 200, 7, 20},
+};
+
+static Clause **make_clause_set(const shape &s, int *n) {
+    generator_options gen;
+    gen.family = "ksat";
+    gen.size = s.num_vars;
+    gen.k = s.k;
+    gen.ratio = s.ratio;
+    gen.seed = 1;
+    uint32_t num_vars;
+    return generate_instance(gen, n, &num_vars);
+}
+
+/**
+ * Root sequent of a shape, with unit clauses of random sign on every units_every-th variable
+ * if units_every is not 0, so that propagation has work to do.
+*/
+static Sequent *make_sequent(const shape &s, int units_every = 0) {
+    int n;
+    Clause **clause_set = make_clause_set(s, &n);
+    if (units_every == 0) return create_root_sequent(clause_set, n);
+
+    int num_units = s.num_vars / units_every;
+    Clause **with_units = new Clause*[n + num_units];
+    copy(clause_set, clause_set + n, with_units);
+    delete []clause_set;
+    for (int i = 0; i < num_units; i++) {
+        literal *literals = new literal[1];
+        literals[0] = {(uint32_t)(i * units_every + 1), i % 3 != 0};
+        with_units[n + i] = new Clause(literals, 1);
+    }
+    return create_root_sequent(with_units, n + num_units);
+}
+
+/**
+ * Times a kernel. prepare builds the inputs of one batch outside the measurement and run processes
+ * them, returning the number of operations done; cleanup frees what both left behind.
+ * Batches are repeated for at least 0.3 s, and the averages per operation are printed.
+*/
+static void measure(const string &kernel, const string &shape_name, const string &unit,
+                    function<void()> prepare, function<uint64_t()> run, function<void()> cleanup) {
+    double seconds = 0;
+    uint64_t ops = 0;
+    uint64_t allocs = 0;
+    uint64_t bytes = 0;
+    for (int batch = 0; batch < 3 || (seconds < 0.3 && ops > 0); batch++) {
+        prepare();
+        uint64_t allocs_before = allocations;
+        uint64_t bytes_before = allocated_bytes;
+        pool_statistics pool_before = get_pool_statistics();
+        chrono::steady_clock::time_point start = chrono::steady_clock::now();
+        ops += run();
+        seconds += chrono::duration<double>(chrono::steady_clock::now() - start).count();
+        pool_statistics pool_after = get_pool_statistics();
+        allocs += allocations - allocs_before + pool_after.misses - pool_before.misses;
+        bytes += allocated_bytes - bytes_before + pool_after.miss_bytes - pool_before.miss_bytes;
+        cleanup();
+    }
+
+    if (ops == 0) return;
+    printf("%-28s %-14s %-12s %12.1f %14.0f %10.2f %12.1f\n", kernel.c_str(), shape_name.c_str(), unit.c_str(),
+           seconds * 1e9 / ops, ops / seconds, (double)allocs / ops, (double)bytes / ops);
+}
+
+static void bench_shape(const shape &s, const string &filter) {
+    auto selected = [&](const string &kernel) { return kernel.find(filter) != string::npos; };
+    const int batch = 64;
+
+    // The sequent after one cut, with the cut literal as a unit clause
+    Sequent *root = make_sequent(s);
+    uint32_t var = choose_cut_var(root);
+    Sequent *cut = atomic_cut_create_sequent(root->clause_set, root->n, var, true);
+    vector<Sequent*> sequents;
+    vector<Clause*> clauses;
+
+    if (selected("is_axiom")) {
+        measure("Sequent::is_axiom", s.name, "call", [] {}, [&] {
+            bool axiom = false;
+            for (int i = 0; i < batch; i++) axiom = cut->is_axiom() || axiom;
+            return (uint64_t)batch + axiom;
+        }, [] {});
+    }
+
+    if (selected("choose_cut_var")) {
+        measure("choose_cut_var", s.name, "call", [] {}, [&] {
+            uint32_t sum = 0;
+            for (int i = 0; i < batch; i++) sum += choose_cut_var(cut);
+            return (uint64_t)batch + (sum == 0);
+        }, [] {});
+    }
+
+    if (selected("propagate")) {
+        // One operation is one unit resolution or subsumption step, from units on every 20th variable
+        Sequent *units = make_sequent(s, 20);
+        measure("Sequent::propagate", s.name, "step", [&] {
+            for (int i = 0; i < batch; i++) sequents.push_back(atomic_cut_create_sequent(units->clause_set, units->n, var, i % 2));
+        }, [&] {
+            uint64_t steps = 0;
+            for (Sequent *seq : sequents)
+                while (seq->propagate()) steps++;
+            return steps;
+        }, [&] {
+            for (Sequent *seq : sequents) free_sequent(seq);
+            sequents.clear();
+        });
+        free_sequent(units);
+    }
+
+    if (selected("atomic_cut_create_sequent")) {
+        measure("atomic_cut_create_sequent", s.name, "sequent", [] {}, [&] {
+            for (int i = 0; i < batch; i++) sequents.push_back(atomic_cut_create_sequent(root->clause_set, root->n, var, i % 2));
+            return (uint64_t)batch;
+        }, [&] {
+            for (Sequent *seq : sequents) free_sequent(seq);
+            sequents.clear();
+        });
+    }
+
+    if (selected("deep_cp_clause")) {
+        measure("deep_cp_clause", s.name, "clause", [] {}, [&] {
+            for (int i = 0; i < root->n; i++) clauses.push_back(deep_cp_clause(root->clause_set[i], var));
+            return (uint64_t)root->n;
+        }, [&] {
+            for (Clause *cl : clauses) free_clause(cl);
+            clauses.clear();
+        });
+    }
+
+    if (selected("read_cnf_file")) {
+        // One operation is one literal of the file
+        char path[] = "/tmp/microbench-XXXXXX";
+        int fd = mkstemp(path);
+        close(fd);
+        uint32_t num_vars = 0;
+        for (int i = 0; i < root->n; i++)
+            for (int j = 0; j < root->clause_set[i]->n; j++) num_vars = max(num_vars, root->clause_set[i]->literals[j].var);
+        write_cnf_file(root->clause_set, root->n, num_vars, path);
+
+        Clause **clause_set = NULL;
+        int n = 0;
+        measure("read_cnf_file", s.name, "literal", [] {}, [&] {
+            clause_set = read_cnf_file(path, &n);
+            uint64_t lits = 0;
+            for (int i = 0; i < n; i++) lits += clause_set[i]->n;
+            return lits;
+        }, [&] {
+            free_clause_set(clause_set, n);
+        });
+        unlink(path);
+    }
+
+    free_sequent(cut);
+    free_sequent(root);
+}
+
+int main(int argc, char **argv) {
+    string filter = argc > 1 ? argv[1] : "";
+
+    printf("%-28s %-14s %-12s %12s %14s %10s %12s\n", "kernel", "shape", "op", "ns/op", "ops/s", "allocs/op", "bytes/op");
+    for (const shape &s : SHAPES)
+        bench_shape(s, filter);
+    return 0;
+}
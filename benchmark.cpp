@@ -0,0 +1,385 @@
+#include <algorithm>
+#include <iomanip>
+#include <dirent.h>
+#include "benchmark.hpp"
+#include "cdcl.hpp"
+
+// Default time limit of a run in seconds, needed for the PAR-2 score
+const double BENCH_DEFAULT_TIME_LIMIT = 60;
+
+static double seconds_since(chrono::steady_clock::time_point start) {
+    return chrono::duration<double>(chrono::steady_clock::now() - start).count();
+}
+
+static bool ends_with(const string &s, const string &suffix) {
+    return s.size() >= suffix.size() && s.compare(s.size() - suffix.size(), suffix.size(), suffix) == 0;
+}
+
+/**
+ * Parses a manifest line "generate FAMILY N [k K] [ratio R] [colors C] [seed S]".
+*/
+static bool parse_generator_line(const string &line, bench_instance *instance) {
+    istringstream words(line);
+    string word;
+    generator_options &gen = instance->generator;
+    if (!(words >> word >> gen.family >> gen.size) || gen.size < 1) return false;
+
+    string key;
+    while (words >> key) {
+        double value;
+        if (!(words >> value) || value < 0) return false;
+        if (key == "k") gen.k = value;
+        else if (key == "ratio") gen.ratio = value;
+        else if (key == "colors") gen.colors = value;
+        else if (key == "seed") gen.seed = value;
+        else return false;
+    }
+
+    instance->name = line.substr(9);
+    replace(instance->name.begin(), instance->name.end(), ' ', '-');
+    return true;
+}
+
+/**
+ * Lists the instances of a benchmark: the .cnf files of a directory in name order, or the lines of
+ * a manifest file. Manifest lines are paths, relative to the manifest unless absolute, or generator
+ * lines; empty lines and lines starting with # are skipped. Returns false, printing the reason,
+ * if the target cannot be read or a line is malformed.
+*/
+bool read_bench_instances(string target, vector<bench_instance> *instances) {
+    DIR *dir = opendir(target.c_str());
+    if (dir != NULL) {
+        vector<string> names;
+        while (struct dirent *entry = readdir(dir)) {
+            if (ends_with(entry->d_name, ".cnf")) names.push_back(entry->d_name);
+        }
+        closedir(dir);
+        sort(names.begin(), names.end());
+
+        string prefix = ends_with(target, "/") ? target : target + "/";
+        for (const string &name : names) instances->push_back({prefix + name, prefix + name, generator_options()});
+        return true;
+    }
+
+    ifstream manifest(target);
+    if (!manifest) {
+        cerr << "Error: cannot read benchmark " << target << endl;
+        return false;
+    }
+
+    size_t slash = target.rfind('/');
+    string base = slash == string::npos ? "" : target.substr(0, slash + 1);
+    string line;
+    int line_number = 0;
+    while (getline(manifest, line)) {
+        line_number++;
+        if (!line.empty() && line.back() == '\r') line.pop_back();
+        size_t first = line.find_first_not_of(" \t");
+        if (first == string::npos || line[first] == '#') continue;
+        line = line.substr(first, line.find_last_not_of(" \t") - first + 1);
+
+        bench_instance instance;
+        if (line.compare(0, 9, "generate ") == 0) {
+            if (!parse_generator_line(line, &instance)) {
+                cerr << "Error: malformed generator on line " << line_number << " of " << target << endl;
+                return false;
+            }
+        } else {
+            instance.name = line;
+            instance.path = line[0] == '/' ? line : base + line;
+        }
+        instances->push_back(instance);
+    }
+    return true;
+}
+
+/**
+ * Reads or generates an instance and decides it once, with the output of the search discarded.
+*/
+static bench_run run_once(const bench_instance &instance, const solve_options &opts) {
+    bench_run run;
+    NullBuffer null_buffer;
+    streambuf *saved = cout.rdbuf(&null_buffer);
+
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    int n;
+    uint32_t num_vars = 0;
+    Clause **clause_set = instance.generator.family.empty() ? read_cnf_file(instance.path, &n, &num_vars)
+                                                            : generate_instance(instance.generator, &n, &num_vars);
+    run.parse = seconds_since(start);
+
+    if (clause_set == NULL) {
+        cout.rdbuf(saved);
+        run.status = "ERROR";
+        return run;
+    }
+
+    chrono::steady_clock::time_point solve_start = chrono::steady_clock::now();
+    SearchBudget budget(opts.limits);
+    CnfFormula original;
+    vector<literal> model;
+    bool res = decide(clause_set, n, opts, &budget, NULL, &original, &model, &run.preprocess);
+    run.solve = seconds_since(solve_start) - run.preprocess;
+    run.total = seconds_since(start);
+
+    if (res == 1) run.status = verify_model(original, num_vars, &model) ? "SAT" : "ERROR";
+    else run.status = budget.stopped() ? "UNKNOWN" : "UNSAT";
+
+    cout.rdbuf(saved);
+    return run;
+}
+
+static double median(vector<double> values) {
+    sort(values.begin(), values.end());
+    size_t k = values.size() / 2;
+    return values.size() % 2 == 1 ? values[k] : (values[k - 1] + values[k]) / 2;
+}
+
+static string json_string(const string &s) {
+    string out = "\"";
+    for (char c : s) {
+        if (c == '"' || c == '\\') out += '\\';
+        if ((unsigned char)c < 0x20) {
+            char escaped[8];
+            snprintf(escaped, sizeof(escaped), "\\u%04x", c);
+            out += escaped;
+        } else {
+            out += c;
+        }
+    }
+    return out + "\"";
+}
+
+/**
+ * Results of an instance over all repetitions. An instance is solved when every repetition
+ * finished with the same answer; its PAR-2 score is the mean over the repetitions of the
+ * total time of solved runs and twice the time limit for the others.
+*/
+struct bench_result {
+    bench_instance instance;
+    vector<bench_run> runs;
+    string status;
+    double par2 = 0;
+    // Score of the instance in the baseline report, negative if it has none
+    double baseline_par2 = -1;
+    string baseline_status;
+
+    bool solved() const { return status == "SAT" || status == "UNSAT"; }
+    double median_of(double bench_run::*field) const {
+        vector<double> values;
+        for (const bench_run &run : runs) values.push_back(run.*field);
+        return median(values);
+    }
+};
+
+static void summarize(bench_result *result, double time_limit) {
+    result->status = result->runs[0].status;
+    double sum = 0;
+    for (const bench_run &run : result->runs) {
+        bool solved = run.status == "SAT" || run.status == "UNSAT";
+        sum += solved ? run.total : 2 * time_limit;
+        if (run.status == "ERROR" || result->status == "ERROR") result->status = "ERROR";
+        else if (run.status == "UNKNOWN" || result->status == "UNKNOWN") result->status = "UNKNOWN";
+        else if (run.status != result->status) result->status = "ERROR";
+    }
+    result->par2 = sum / result->runs.size();
+}
+
+/**
+ * Extracts the value of a key from a line of a JSON report written by write_json.
+*/
+static bool json_value(const string &line, const string &key, string *value) {
+    string pattern = "\"" + key + "\": ";
+    size_t pos = line.find(pattern);
+    if (pos == string::npos) return false;
+    pos += pattern.size();
+
+    value->clear();
+    if (line[pos] != '"') {
+        size_t end = line.find_first_of(",}", pos);
+        *value = line.substr(pos, end - pos);
+        return true;
+    }
+    for (pos++; pos < line.size() && line[pos] != '"'; pos++) {
+        if (line[pos] == '\\') pos++;
+        *value += line[pos];
+    }
+    return true;
+}
+
+/**
+ * Reads the PAR-2 score and status of every instance of a report written by write_json,
+ * which has one instance per line. Returns false if the file cannot be read.
+*/
+static bool read_baseline(string filename, vector<bench_result> *results) {
+    ifstream input(filename);
+    if (!input) return false;
+
+    map<string, pair<double, string>> baseline;
+    string line;
+    while (getline(input, line)) {
+        string name, par2, status;
+        if (json_value(line, "name", &name) && json_value(line, "par2", &par2) && json_value(line, "status", &status))
+            baseline[name] = make_pair(atof(par2.c_str()), status);
+    }
+
+    for (bench_result &result : *results) {
+        auto it = baseline.find(result.instance.name);
+        if (it == baseline.end()) continue;
+        result.baseline_par2 = it->second.first;
+        result.baseline_status = it->second.second;
+    }
+    return true;
+}
+
+static void write_json(ostream &out, const bench_options &bench, double time_limit, const vector<bench_result> &results,
+                       int solved, double par2, double baseline_par2, double compared_par2) {
+    out << setprecision(6);
+    out << "{\n";
+    out << "  \"command\": " << json_string(bench.command) << ",\n";
+    out << "  \"time_limit\": " << time_limit << ",\n";
+    out << "  \"repetitions\": " << bench.repetitions << ",\n";
+    out << "  \"instances\": [\n";
+    for (size_t i = 0; i < results.size(); i++) {
+        const bench_result &r = results[i];
+        out << "    {\"name\": " << json_string(r.instance.name) << ", \"status\": \"" << r.status << "\", \"par2\": " << r.par2
+            << ", \"parse\": " << r.median_of(&bench_run::parse) << ", \"preprocess\": " << r.median_of(&bench_run::preprocess)
+            << ", \"solve\": " << r.median_of(&bench_run::solve) << ", \"total\": " << r.median_of(&bench_run::total);
+        if (r.baseline_par2 >= 0) out << ", \"baseline_par2\": " << r.baseline_par2;
+        out << ", \"runs\": [";
+        for (size_t j = 0; j < r.runs.size(); j++) {
+            const bench_run &run = r.runs[j];
+            out << (j > 0 ? ", " : "") << "{\"status\": \"" << run.status << "\", \"parse\": " << run.parse
+                << ", \"preprocess\": " << run.preprocess << ", \"solve\": " << run.solve << ", \"total\": " << run.total << "}";
+        }
+        out << "]}" << (i + 1 < results.size() ? "," : "") << "\n";
+    }
+    out << "  ],\n";
+    out << "  \"summary\": {\"instances\": " << results.size() << ", \"solved\": " << solved << ", \"par2\": " << par2;
+    if (baseline_par2 >= 0) out << ", \"baseline_par2\": " << baseline_par2 << ", \"compared_par2\": " << compared_par2;
+    out << "}\n";
+    out << "}\n";
+}
+
+static string csv_string(const string &s) {
+    string out = "\"";
+    for (char c : s) out += c == '"' ? string("\"\"") : string(1, c);
+    return out + "\"";
+}
+
+static void write_csv(ostream &out, const vector<bench_result> &results) {
+    out << setprecision(6);
+    out << "instance,repetition,status,parse_s,preprocess_s,solve_s,total_s\n";
+    for (const bench_result &r : results)
+        for (size_t j = 0; j < r.runs.size(); j++) {
+            const bench_run &run = r.runs[j];
+            out << csv_string(r.instance.name) << "," << j + 1 << "," << run.status << "," << run.parse << ","
+                << run.preprocess << "," << run.solve << "," << run.total << "\n";
+        }
+}
+
+/**
+ * Prints how the results compare with the baseline: instances whose score changed by more than 10%
+ * or that changed between solved and unsolved, and the PAR-2 scores of both over the common instances.
+ * Returns the baseline score, negative if no instance is common.
+*/
+static double compare_baseline(const vector<bench_result> &results, double *compared_par2) {
+    double base_sum = 0;
+    double sum = 0;
+    int common = 0, faster = 0, slower = 0, gained = 0, lost = 0;
+    for (const bench_result &r : results) {
+        if (r.baseline_par2 < 0) continue;
+        common++;
+        base_sum += r.baseline_par2;
+        sum += r.par2;
+
+        bool base_solved = r.baseline_status == "SAT" || r.baseline_status == "UNSAT";
+        if (r.solved() && !base_solved) gained++;
+        else if (!r.solved() && base_solved) lost++;
+        else if (r.par2 < 0.9 * r.baseline_par2) faster++;
+        else if (r.par2 > 1.1 * r.baseline_par2) slower++;
+        else continue;
+        cout << "c   " << r.instance.name << ": " << r.baseline_status << " " << r.baseline_par2 << " s -> "
+             << r.status << " " << r.par2 << " s" << endl;
+    }
+    if (common == 0) {
+        cout << "c Baseline: no instance in common" << endl;
+        return -1;
+    }
+
+    *compared_par2 = sum / common;
+    cout << "c Baseline: PAR-2 " << base_sum / common << " -> " << *compared_par2 << " over " << common
+         << " instances, " << faster << " faster, " << slower << " slower, " << gained << " newly solved, "
+         << lost << " no longer solved" << endl;
+    return base_sum / common;
+}
+
+/**
+ * Runs every instance of a benchmark the given number of times with the search of the options,
+ * prints a 'c' line per instance and a summary, and writes the JSON and CSV reports if asked.
+ * Without a time limit, runs are limited to BENCH_DEFAULT_TIME_LIMIT seconds.
+ * Returns the exit status: 1 if the benchmark cannot be read or an instance ended in an error.
+*/
+int run_benchmark(const bench_options &bench, solve_options opts) {
+    vector<bench_instance> instances;
+    if (!read_bench_instances(bench.target, &instances)) return 1;
+    if (opts.limits.time_limit == 0) opts.limits.time_limit = BENCH_DEFAULT_TIME_LIMIT;
+    double time_limit = opts.limits.time_limit;
+
+    cout << "c Benchmark: " << instances.size() << " instances, " << bench.repetitions << " repetitions, "
+         << time_limit << " s time limit" << endl;
+
+    vector<bench_result> results;
+    bool interrupted = false;
+    for (const bench_instance &instance : instances) {
+        bench_result result;
+        result.instance = instance;
+        for (int rep = 0; rep < bench.repetitions && !interrupted; rep++) {
+            // The searches read the clause set from the start, so every repetition parses it again
+            result.runs.push_back(run_once(instance, opts));
+            interrupted = opts.limits.terminate != NULL && opts.limits.terminate->load();
+        }
+        if (interrupted) break;
+
+        summarize(&result, time_limit);
+        cout << "c " << instance.name << " " << result.status << " " << result.median_of(&bench_run::total) << " s (parse "
+             << result.median_of(&bench_run::parse) << ", preprocess " << result.median_of(&bench_run::preprocess)
+             << ", solve " << result.median_of(&bench_run::solve) << ")" << endl;
+        results.push_back(result);
+    }
+    if (interrupted) cout << "c Interrupted, " << results.size() << " of " << instances.size() << " instances run" << endl;
+
+    int solved = 0, sat = 0, unsat = 0, unknown = 0, errors = 0;
+    double sum = 0;
+    for (const bench_result &r : results) {
+        solved += r.solved();
+        sat += r.status == "SAT";
+        unsat += r.status == "UNSAT";
+        unknown += r.status == "UNKNOWN";
+        errors += r.status == "ERROR";
+        sum += r.par2;
+    }
+    double par2 = results.empty() ? 0 : sum / results.size();
+    cout << "c Solved " << solved << " of " << results.size() << " (" << sat << " SAT, " << unsat << " UNSAT), "
+         << unknown << " unknown, " << errors << " errors, PAR-2 " << par2 << endl;
+
+    double baseline_par2 = -1;
+    double compared_par2 = 0;
+    if (!bench.baseline_file.empty()) {
+        if (read_baseline(bench.baseline_file, &results)) baseline_par2 = compare_baseline(results, &compared_par2);
+        else cerr << "Error: cannot read baseline " << bench.baseline_file << endl;
+    }
+
+    if (!bench.json_file.empty()) {
+        ofstream json(bench.json_file);
+        if (!json) cerr << "Error: cannot write " << bench.json_file << endl;
+        write_json(json, bench, time_limit, results, solved, par2, baseline_par2, compared_par2);
+    }
+    if (!bench.csv_file.empty()) {
+        ofstream csv(bench.csv_file);
+        if (!csv) cerr << "Error: cannot write " << bench.csv_file << endl;
+        write_csv(csv, results);
+    }
+
+    return errors > 0 ? 1 : 0;
+}
@@ -0,0 +1,51 @@
+#ifndef BENCHMARK_H
+#define BENCHMARK_H
+
+#include "SAT-solver.hpp"
+#include "generate.hpp"
+
+/**
+ * A benchmark instance: a CNF file, or a generated instance if generator.family is set.
+*/
+struct bench_instance {
+    string name;
+    string path;
+    generator_options generator;
+};
+
+/**
+ * Timings of one run in seconds. status is SAT, UNSAT, UNKNOWN, or ERROR for an unreadable
+ * instance or a model that fails verification.
+*/
+struct bench_run {
+    string status;
+    double parse = 0;
+    double preprocess = 0;
+    double solve = 0;
+    double total = 0;
+};
+
+struct bench_options {
+    // Directory of .cnf files or manifest file
+    string target;
+    int repetitions = 1;
+    string json_file;
+    string csv_file;
+    // Report written by an earlier run to compare against
+    string baseline_file;
+    // Command line, recorded in the report
+    string command;
+};
+
+/**
+ * Discards everything written to it, to keep the output of the searches out of the report.
+*/
+class NullBuffer : public streambuf {
+    protected:
+        int overflow(int c) { return c; }
+};
+
+bool read_bench_instances(string target, vector<bench_instance> *instances);
+int run_benchmark(const bench_options &bench, solve_options opts);
+
+#endif
@@ -0,0 +1,97 @@
+#include <algorithm>
+#include "bigint.hpp"
+
+BigInt::BigInt(uint64_t value) {
+    while (value != 0) {
+        limbs.push_back((uint32_t)value);
+        value >>= 32;
+    }
+}
+
+void BigInt::trim() {
+    while (!limbs.empty() && limbs.back() == 0) limbs.pop_back();
+}
+
+BigInt &BigInt::operator+=(const BigInt &other) {
+    if (limbs.size() < other.limbs.size()) limbs.resize(other.limbs.size(), 0);
+
+    uint64_t carry = 0;
+    for (size_t i = 0; i < limbs.size(); i++) {
+        uint64_t sum = carry + limbs[i] + (i < other.limbs.size() ? other.limbs[i] : 0);
+        limbs[i] = (uint32_t)sum;
+        carry = sum >> 32;
+        if (carry == 0 && i >= other.limbs.size()) break;
+    }
+    if (carry != 0) limbs.push_back((uint32_t)carry);
+
+    return *this;
+}
+
+BigInt BigInt::operator*(const BigInt &other) const {
+    BigInt product;
+    if (is_zero() || other.is_zero()) return product;
+
+    // Schoolbook multiplication, counts rarely have more than a few hundred limbs
+    product.limbs.assign(limbs.size() + other.limbs.size(), 0);
+    for (size_t i = 0; i < limbs.size(); i++) {
+        uint64_t carry = 0;
+        for (size_t j = 0; j < other.limbs.size(); j++) {
+            uint64_t cur = product.limbs[i+j] + (uint64_t)limbs[i] * other.limbs[j] + carry;
+            product.limbs[i+j] = (uint32_t)cur;
+            carry = cur >> 32;
+        }
+        product.limbs[i + other.limbs.size()] = (uint32_t)carry;
+    }
+    product.trim();
+
+    return product;
+}
+
+/**
+ * Multiplies by 2^bits.
+*/
+BigInt &BigInt::shift_left(uint64_t bits) {
+    if (is_zero() || bits == 0) return *this;
+
+    size_t words = bits / 32;
+    int rest = bits % 32;
+    if (rest != 0) {
+        uint32_t carry = 0;
+        for (uint32_t &limb : limbs) {
+            uint32_t next = limb >> (32 - rest);
+            limb = (limb << rest) | carry;
+            carry = next;
+        }
+        if (carry != 0) limbs.push_back(carry);
+    }
+    limbs.insert(limbs.begin(), words, 0);
+
+    return *this;
+}
+
+/**
+ * Decimal representation, by repeated division by 10^9.
+*/
+string BigInt::to_string() const {
+    if (is_zero()) return "0";
+
+    vector<uint32_t> rest = limbs;
+    vector<uint32_t> chunks;
+    while (!rest.empty()) {
+        uint64_t rem = 0;
+        for (size_t i = rest.size(); i > 0; i--) {
+            uint64_t cur = (rem << 32) | rest[i-1];
+            rest[i-1] = (uint32_t)(cur / 1000000000);
+            rem = cur % 1000000000;
+        }
+        while (!rest.empty() && rest.back() == 0) rest.pop_back();
+        chunks.push_back((uint32_t)rem);
+    }
+
+    string s = std::to_string(chunks.back());
+    for (size_t i = chunks.size() - 1; i > 0; i--) {
+        string chunk = std::to_string(chunks[i-1]);
+        s += string(9 - chunk.size(), '0') + chunk;
+    }
+    return s;
+}
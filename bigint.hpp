@@ -0,0 +1,27 @@
+#ifndef BIGINT_H
+#define BIGINT_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+using namespace std;
+
+/**
+ * Unsigned integer of arbitrary size, for model counts that overflow 64 bits.
+ * Stored as base 2^32 limbs, least significant first, without leading zero limbs.
+*/
+class BigInt {
+    public:
+        BigInt(uint64_t value = 0);
+        bool is_zero() const { return limbs.empty(); }
+        size_t bytes() const { return limbs.size() * sizeof(uint32_t); }
+        BigInt &operator+=(const BigInt &other);
+        BigInt operator*(const BigInt &other) const;
+        BigInt &shift_left(uint64_t bits);
+        string to_string() const;
+    private:
+        vector<uint32_t> limbs;
+        void trim();
+};
+
+#endif
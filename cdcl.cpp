@@ -0,0 +1,989 @@
+#include <algorithm>
+#include "cdcl.hpp"
+#include "classify.hpp"
+#include "proof.hpp"
+#include "stats.hpp"
+#include "trace.hpp"
+#include "memory.hpp"
+#include "checkpoint.hpp"
+
+/**
+ * Converts a clause set into the flat, normalized form shared by the CDCL solvers.
+*/
+void build_cnf_formula(Clause **clause_set, int n, CnfFormula *formula) {
+    formula->num_vars = max_var_of(clause_set, n);
+    formula->start.assign(1, 0);
+    formula->lits.clear();
+    formula->has_empty = false;
+
+    vector<uint32_t> lits;
+    for (int i = 0; i < n; i++) {
+        lits.clear();
+        for (int j = 0; j < clause_set[i]->n; j++) {
+            literal lit = clause_set[i]->literals[j];
+            lits.push_back(mk_lit(lit.var, lit.positive));
+        }
+        sort(lits.begin(), lits.end());
+        lits.erase(unique(lits.begin(), lits.end()), lits.end());
+
+        bool tautology = false;
+        for (size_t j = 1; j < lits.size(); j++)
+            if (lits[j] == (lits[j-1] ^ 1)) tautology = true;
+        if (tautology) continue;
+
+        if (lits.empty()) formula->has_empty = true;
+        formula->lits.insert(formula->lits.end(), lits.begin(), lits.end());
+        formula->start.push_back(formula->lits.size());
+    }
+}
+
+static uint64_t hash_clause(const uint32_t *lits, uint32_t size) {
+    // FNV-1a
+    uint64_t h = 14695981039346656037ull;
+    for (uint32_t i = 0; i < size; i++) {
+        h ^= lits[i];
+        h *= 1099511628211ull;
+    }
+    return h;
+}
+
+static uint64_t luby(uint64_t i) {
+    // Finds the finite subsequence containing index i, and i's position in it
+    uint64_t size = 1;
+    int seq = 0;
+    while (size < i + 1) {
+        seq++;
+        size = 2 * size + 1;
+    }
+    while (size - 1 != i) {
+        size = (size - 1) >> 1;
+        seq--;
+        i = i % size;
+    }
+    return 1ull << seq;
+}
+
+CdclSolver::CdclSolver(const CnfFormula *formula, uint32_t seed, bool diversify) {
+    this->formula = formula;
+    uint32_t n = formula != NULL ? formula->num_vars : 0;
+
+    level_stamp.assign(1, 0);
+    max_learnts = (formula != NULL ? formula->num_clauses() / 3.0 : 0) + 2000;
+
+    rng = seed * 2654435761u + 2463534242u;
+    if (rng == 0) rng = 1;
+
+    ensure_vars(n);
+    if (diversify) {
+        // Different initial orders, phases and restart intervals per thread
+        for (uint32_t v = 1; v <= n; v++) {
+            activity[v] = (next_random() % 1000) * 1e-5;
+            phase[v] = next_random() & 1;
+            heap_up(heap_pos[v]);
+        }
+        restart_base = 50 + 50 * (seed % 4);
+    }
+
+    ok = formula == NULL || !formula->has_empty;
+    if (formula == NULL) return;
+
+    for (uint32_t i = 0; i < formula->num_clauses() && ok; i++) {
+        const uint32_t *lits = &formula->lits[formula->start[i]];
+        uint32_t size = formula->start[i+1] - formula->start[i];
+
+        if (size == 1) {
+            if (vals[lits[0]] == -1) ok = false;
+            else if (vals[lits[0]] == 0) enqueue(lits[0], CREF_NONE);
+        } else {
+            attach_clause(lits, size, false);
+        }
+    }
+}
+
+CdclSolver::~CdclSolver() {
+    for (ClauseInfo &c : clauses)
+        if (c.owned) delete [](c.lits);
+    memory_release(MEM_CDCL, memory_reported);
+}
+
+/**
+ * Estimated bytes of a clause in the database: its entry, its two watchers and its literals.
+*/
+static uint64_t clause_memory(uint32_t size) {
+    return sizeof(ClauseInfo) + 2 * sizeof(Watcher) + size * sizeof(uint32_t);
+}
+
+/**
+ * Brings the memory accounting up to date with the clause database. Called between restarts
+ * rather than per clause, to keep the shared counters out of the conflict loop.
+*/
+void CdclSolver::report_memory() {
+    if (memory_bytes > memory_reported) memory_add(MEM_CDCL, memory_bytes - memory_reported);
+    else memory_release(MEM_CDCL, memory_reported - memory_bytes);
+    memory_reported = memory_bytes;
+}
+
+/**
+ * Makes variables 1 .. n available, adding any new ones to the branching heap.
+*/
+void CdclSolver::ensure_vars(uint32_t n) {
+    uint32_t old_n = num_vars();
+    if (n <= old_n && !vals.empty()) return;
+
+    vals.resize(2 * (n + 1), 0);
+    level.resize(n + 1, 0);
+    reason.resize(n + 1, CREF_NONE);
+    activity.resize(n + 1, 0.0);
+    phase.resize(n + 1, false);
+    priority.resize(n + 1, 0);
+    seen.resize(n + 1, 0);
+    level_stamp.resize(n + 2, 0);
+    heap_pos.resize(n + 1, -1);
+    watches.resize(2 * (n + 1));
+
+    for (uint32_t v = old_n + 1; v <= n; v++)
+        heap_insert(v);
+}
+
+/**
+ * Adds a clause over literal codes. Must be called between solve() calls, when the solver
+ * is at decision level 0: the clause is simplified with the permanent assignment, and
+ * its literals are copied into storage owned by the solver.
+ * Returns false if the solver has become unsatisfiable without assumptions.
+*/
+bool CdclSolver::add_clause(const vector<uint32_t> &lits) {
+    if (!ok) return false;
+
+    uint32_t max_var = 0;
+    for (uint32_t lit : lits) max_var = max(max_var, lit_var(lit));
+    ensure_vars(max_var);
+
+    vector<uint32_t> sorted(lits);
+    sort(sorted.begin(), sorted.end());
+    sorted.erase(unique(sorted.begin(), sorted.end()), sorted.end());
+
+    vector<uint32_t> simplified;
+    for (size_t i = 0; i < sorted.size(); i++) {
+        // Tautology, or satisfied at level 0
+        if (i > 0 && sorted[i] == (sorted[i-1] ^ 1)) return true;
+        if (vals[sorted[i]] == 1) return true;
+        if (vals[sorted[i]] == 0) simplified.push_back(sorted[i]);
+    }
+
+    if (simplified.empty()) {
+        ok = false;
+    } else if (simplified.size() == 1) {
+        enqueue(simplified[0], CREF_NONE);
+    } else {
+        uint32_t *copy = new uint32_t[simplified.size()];
+        for (size_t i = 0; i < simplified.size(); i++) copy[i] = simplified[i];
+        uint32_t cref = attach_clause(copy, simplified.size(), false);
+        clauses[cref].owned = true;
+    }
+
+    return ok;
+}
+
+void CdclSolver::set_sharing(SharedClauses *shared, int id) {
+    this->shared = shared;
+    share_id = id;
+    share_cursor.assign(shared->rings.size(), 0);
+}
+
+uint32_t CdclSolver::next_random() {
+    // xorshift32
+    rng ^= rng << 13;
+    rng ^= rng >> 17;
+    rng ^= rng << 5;
+    return rng;
+}
+
+bool CdclSolver::model_value(uint32_t var) {
+    return var < model.size() && model[var] == 1;
+}
+
+void CdclSolver::enqueue(uint32_t lit, uint32_t from) {
+    uint32_t var = lit_var(lit);
+    vals[lit] = 1;
+    vals[lit ^ 1] = -1;
+    level[var] = decision_level();
+    reason[var] = from;
+    trail.push_back(lit);
+}
+
+uint32_t CdclSolver::attach_clause(const uint32_t *lits, uint32_t size, bool learnt) {
+    uint32_t cref = clauses.size();
+    ClauseInfo c;
+    c.lits = lits;
+    c.size = size;
+    c.watch[0] = 0;
+    c.watch[1] = 1;
+    c.lbd = size;
+    c.learnt = learnt;
+    c.owned = learnt;
+    c.imported = false;
+    c.used = false;
+    c.deleted = false;
+    clauses.push_back(c);
+    memory_bytes += clause_memory(size);
+
+    watches[lits[0]].push_back({cref, lits[1]});
+    watches[lits[1]].push_back({cref, lits[0]});
+    return cref;
+}
+
+uint32_t CdclSolver::add_learnt(const vector<uint32_t> &lits, uint32_t lbd) {
+    uint32_t *copy = new uint32_t[lits.size()];
+    for (size_t i = 0; i < lits.size(); i++) copy[i] = lits[i];
+
+    uint32_t cref = attach_clause(copy, lits.size(), true);
+    clauses[cref].lbd = lbd;
+    num_learnts++;
+    return cref;
+}
+
+/**
+ * Propagates all enqueued literals with two watched literals per clause.
+ * Returns the conflicting clause, or CREF_NONE.
+*/
+uint32_t CdclSolver::propagate() {
+    TRACE_SCOPE("cdcl propagate");
+    uint32_t confl = CREF_NONE;
+
+    while (qhead < trail.size()) {
+        uint32_t false_lit = trail[qhead++] ^ 1;
+        vector<Watcher> &ws = watches[false_lit];
+        stats.propagations++;
+
+        size_t i = 0;
+        size_t j = 0;
+        while (i < ws.size()) {
+            Watcher w = ws[i++];
+            if (vals[w.blocker] == 1) {
+                ws[j++] = w;
+                continue;
+            }
+
+            ClauseInfo &c = clauses[w.cref];
+            if (c.deleted) continue;
+
+            int me = c.lits[c.watch[0]] == false_lit ? 0 : 1;
+            uint32_t other = c.lits[c.watch[1 - me]];
+            if (vals[other] == 1) {
+                ws[j++] = {w.cref, other};
+                continue;
+            }
+
+            // Looks for a new literal to watch
+            bool moved = false;
+            for (uint32_t k = 0; k < c.size; k++) {
+                if (k == c.watch[0] || k == c.watch[1]) continue;
+                if (vals[c.lits[k]] != -1) {
+                    c.watch[me] = k;
+                    watches[c.lits[k]].push_back({w.cref, other});
+                    moved = true;
+                    break;
+                }
+            }
+            if (moved) continue;
+
+            ws[j++] = w;
+            if (vals[other] == -1) {
+                // Conflict
+                confl = w.cref;
+                qhead = trail.size();
+                while (i < ws.size()) ws[j++] = ws[i++];
+            } else {
+                enqueue(other, w.cref);
+            }
+        }
+        ws.resize(j);
+    }
+
+    return confl;
+}
+
+/**
+ * First-UIP conflict analysis. The asserting literal is placed first in the learnt clause,
+ * and a literal of the backjump level second, so both can be watched.
+*/
+void CdclSolver::analyze(uint32_t confl, vector<uint32_t> &out_learnt, int *out_btlevel, uint32_t *out_lbd) {
+    TRACE_SCOPE("cdcl analyze");
+    int path = 0;
+    uint32_t p = LIT_UNDEF;
+    int index = trail.size() - 1;
+    uint32_t cref = confl;
+
+    out_learnt.clear();
+    out_learnt.push_back(LIT_UNDEF);
+
+    do {
+        ClauseInfo &c = clauses[cref];
+        if (c.imported && !c.used) stats.useful++;
+        c.used = true;
+
+        for (uint32_t k = 0; k < c.size; k++) {
+            uint32_t q = c.lits[k];
+            if (q == p) continue;
+            uint32_t v = lit_var(q);
+            if (seen[v] || level[v] == 0) continue;
+
+            seen[v] = 1;
+            bump_var(v);
+            if (level[v] >= decision_level()) path++;
+            else out_learnt.push_back(q);
+        }
+
+        // Next literal of the current level to resolve on
+        while (!seen[lit_var(trail[index])]) index--;
+        p = trail[index--];
+        cref = reason[lit_var(p)];
+        seen[lit_var(p)] = 0;
+        path--;
+    } while (path > 0);
+    out_learnt[0] = p ^ 1;
+
+    // Removes literals implied by the other literals of the clause
+    analyze_clear.assign(out_learnt.begin() + 1, out_learnt.end());
+    size_t j = 1;
+    for (size_t i = 1; i < out_learnt.size(); i++) {
+        uint32_t v = lit_var(out_learnt[i]);
+        bool redundant = reason[v] != CREF_NONE;
+        if (redundant) {
+            ClauseInfo &r = clauses[reason[v]];
+            for (uint32_t k = 0; k < r.size; k++) {
+                uint32_t u = lit_var(r.lits[k]);
+                if (u != v && !seen[u] && level[u] > 0) {
+                    redundant = false;
+                    break;
+                }
+            }
+        }
+        if (!redundant) out_learnt[j++] = out_learnt[i];
+    }
+    out_learnt.resize(j);
+    for (uint32_t lit : analyze_clear)
+        seen[lit_var(lit)] = 0;
+
+    if (out_learnt.size() == 1) {
+        *out_btlevel = 0;
+    } else {
+        size_t max_i = 1;
+        for (size_t i = 2; i < out_learnt.size(); i++)
+            if (level[lit_var(out_learnt[i])] > level[lit_var(out_learnt[max_i])]) max_i = i;
+        swap(out_learnt[1], out_learnt[max_i]);
+        *out_btlevel = level[lit_var(out_learnt[1])];
+    }
+
+    // Literal block distance: number of distinct decision levels
+    stamp++;
+    *out_lbd = 0;
+    for (uint32_t lit : out_learnt) {
+        int l = level[lit_var(lit)];
+        if (level_stamp[l] != stamp) {
+            level_stamp[l] = stamp;
+            (*out_lbd)++;
+        }
+    }
+}
+
+void CdclSolver::cancel_until(int lvl) {
+    if (decision_level() <= lvl) return;
+
+    for (size_t i = trail.size(); i > trail_lim[lvl]; i--) {
+        uint32_t lit = trail[i-1];
+        uint32_t v = lit_var(lit);
+        phase[v] = lit_positive(lit);
+        vals[lit] = 0;
+        vals[lit ^ 1] = 0;
+        reason[v] = CREF_NONE;
+        if (heap_pos[v] < 0) heap_insert(v);
+    }
+    trail.resize(trail_lim[lvl]);
+    trail_lim.resize(lvl);
+    qhead = trail.size();
+}
+
+uint32_t CdclSolver::pick_branch() {
+    while (!heap.empty()) {
+        uint32_t v = heap_pop();
+        if (vals[mk_lit(v, true)] == 0) return mk_lit(v, phase[v]);
+    }
+    return LIT_UNDEF;
+}
+
+void CdclSolver::bump_var(uint32_t var) {
+    activity[var] += var_inc;
+    if (activity[var] > 1e100) {
+        for (double &a : activity) a *= 1e-100;
+        var_inc *= 1e-100;
+    }
+    if (heap_pos[var] >= 0) heap_up(heap_pos[var]);
+}
+
+void CdclSolver::heap_insert(uint32_t var) {
+    heap_pos[var] = heap.size();
+    heap.push_back(var);
+    heap_up(heap_pos[var]);
+}
+
+uint32_t CdclSolver::heap_pop() {
+    uint32_t top = heap[0];
+    heap[0] = heap.back();
+    heap_pos[heap[0]] = 0;
+    heap.pop_back();
+    heap_pos[top] = -1;
+    if (!heap.empty()) heap_down(0);
+    return top;
+}
+
+void CdclSolver::heap_up(int i) {
+    uint32_t var = heap[i];
+    while (i > 0) {
+        int parent = (i - 1) / 2;
+        if (!heap_above(var, heap[parent])) break;
+        heap[i] = heap[parent];
+        heap_pos[heap[i]] = i;
+        i = parent;
+    }
+    heap[i] = var;
+    heap_pos[var] = i;
+}
+
+void CdclSolver::heap_down(int i) {
+    uint32_t var = heap[i];
+    int size = heap.size();
+    while (2 * i + 1 < size) {
+        int child = 2 * i + 1;
+        if (child + 1 < size && heap_above(heap[child+1], heap[child])) child++;
+        if (!heap_above(heap[child], var)) break;
+        heap[i] = heap[child];
+        heap_pos[heap[i]] = i;
+        i = child;
+    }
+    heap[i] = var;
+    heap_pos[var] = i;
+}
+
+/**
+ * Deletes the worse half of the learnt clauses with an LBD above 2, ranked by LBD and size.
+ * Only called at decision level 0, where no clause is the reason of a literal needed in analysis,
+ * so the clause database can be compacted and the watch lists rebuilt.
+*/
+void CdclSolver::reduce_db() {
+    TRACE_SCOPE("cdcl reduce_db");
+    vector<uint32_t> candidates;
+    for (uint32_t i = 0; i < clauses.size(); i++)
+        if (clauses[i].learnt && clauses[i].lbd > 2) candidates.push_back(i);
+
+    sort(candidates.begin(), candidates.end(), [this](uint32_t a, uint32_t b) {
+        if (clauses[a].lbd != clauses[b].lbd) return clauses[a].lbd > clauses[b].lbd;
+        return clauses[a].size > clauses[b].size;
+    });
+    for (size_t i = 0; i < candidates.size() / 2; i++)
+        clauses[candidates[i]].deleted = true;
+
+    if (proof != NULL) {
+        // Level 0 literals lose their reasons below, so the proof keeps them as units
+        for (uint32_t lit : trail)
+            if (reason[lit_var(lit)] != CREF_NONE) proof->add(&lit, 1);
+        for (uint32_t i : candidates)
+            if (clauses[i].deleted) proof->remove(clauses[i].lits, clauses[i].size);
+    }
+
+    vector<ClauseInfo> kept;
+    kept.reserve(clauses.size());
+    for (ClauseInfo &c : clauses) {
+        if (c.deleted) {
+            delete [](c.lits);
+            num_learnts--;
+            memory_bytes -= clause_memory(c.size);
+        } else {
+            kept.push_back(c);
+        }
+    }
+    clauses.swap(kept);
+
+    for (vector<Watcher> &ws : watches) ws.clear();
+    for (uint32_t i = 0; i < clauses.size(); i++) {
+        ClauseInfo &c = clauses[i];
+        watches[c.lits[c.watch[0]]].push_back({i, c.lits[c.watch[1]]});
+        watches[c.lits[c.watch[1]]].push_back({i, c.lits[c.watch[0]]});
+    }
+    for (uint32_t lit : trail) reason[lit_var(lit)] = CREF_NONE;
+
+    max_learnts *= 1.1;
+}
+
+/**
+ * Hands the learnt clauses, the units of level 0, the activities and the phases to the checkpoint writer.
+*/
+void CdclSolver::save_state() {
+    checkpoint_state state;
+    state.kind = CHECKPOINT_CDCL;
+    size_t units = trail_lim.empty() ? trail.size() : trail_lim[0];
+    for (size_t i = 0; i < units; i++) {
+        state.learnts.push_back({trail[i]});
+        state.lbds.push_back(1);
+    }
+    for (const ClauseInfo &c : clauses) {
+        if (!c.learnt || c.deleted) continue;
+        state.learnts.push_back(vector<uint32_t>(c.lits, c.lits + c.size));
+        state.lbds.push_back(c.lbd);
+    }
+    state.var_inc = var_inc;
+    state.activity = activity;
+    state.phase = phase;
+    checkpoint->save(move(state));
+}
+
+/**
+ * Continues from a checkpoint of the same formula: restores the activities and phases, and adds the
+ * saved clauses as learnt clauses, simplified with the permanent assignment. Called before solve().
+*/
+void CdclSolver::load_state(const checkpoint_state &state) {
+    uint32_t n = num_vars();
+    for (uint32_t v = 1; v <= n && v < state.activity.size(); v++) {
+        activity[v] = state.activity[v];
+        phase[v] = state.phase[v];
+    }
+    var_inc = state.var_inc;
+    for (size_t i = 0; i < heap.size(); i++) heap_up(i);
+
+    for (size_t i = 0; i < state.learnts.size() && ok; i++) {
+        vector<uint32_t> simplified;
+        bool satisfied = false;
+        for (uint32_t lit : state.learnts[i]) {
+            if (lit_var(lit) == 0 || lit_var(lit) > n || vals[lit] == 1) {
+                satisfied = true;
+                break;
+            }
+            if (vals[lit] == 0) simplified.push_back(lit);
+        }
+        if (satisfied) continue;
+
+        if (simplified.empty()) ok = false;
+        else if (simplified.size() == 1) enqueue(simplified[0], CREF_NONE);
+        else add_learnt(simplified, state.lbds[i]);
+    }
+}
+
+/**
+ * Publishes a short learnt clause to the other threads, unless it was already shared.
+*/
+void CdclSolver::export_clause(const vector<uint32_t> &lits) {
+    if (shared == NULL) return;
+    if (lits.size() > SHARE_MAX_SIZE) {
+        stats.filtered_size++;
+        return;
+    }
+
+    uint32_t sorted[SHARE_MAX_SIZE];
+    copy(lits.begin(), lits.end(), sorted);
+    sort(sorted, sorted + lits.size());
+    if (!shared_hashes.insert(hash_clause(sorted, lits.size())).second) {
+        stats.filtered_duplicate++;
+        return;
+    }
+
+    shared->rings[share_id]->push(sorted, lits.size());
+    stats.exported++;
+}
+
+/**
+ * Adds a clause learnt by another thread. Only called at decision level 0,
+ * so the clause can be simplified with the permanent assignment first.
+*/
+void CdclSolver::import_clause(const uint32_t *lits, uint32_t size) {
+    if (!shared_hashes.insert(hash_clause(lits, size)).second) {
+        stats.filtered_duplicate++;
+        return;
+    }
+
+    vector<uint32_t> simplified;
+    for (uint32_t i = 0; i < size; i++) {
+        // Satisfied
+        if (vals[lits[i]] == 1) return;
+        if (vals[lits[i]] == 0) simplified.push_back(lits[i]);
+    }
+    stats.imported++;
+
+    if (simplified.empty()) {
+        ok = false;
+    } else if (simplified.size() == 1) {
+        enqueue(simplified[0], CREF_NONE);
+    } else {
+        uint32_t cref = add_learnt(simplified, simplified.size());
+        clauses[cref].imported = true;
+    }
+}
+
+void CdclSolver::import_shared() {
+    if (shared == NULL) return;
+
+    uint32_t lits[SHARE_MAX_SIZE];
+    uint32_t size;
+    for (size_t r = 0; r < shared->rings.size() && ok; r++) {
+        if ((int)r == share_id) continue;
+
+        ShareRing *ring = shared->rings[r];
+        uint64_t head = ring->published();
+        if (head - share_cursor[r] > SHARE_RING_CAPACITY) {
+            // Overrun by the producer
+            stats.dropped += head - share_cursor[r] - SHARE_RING_CAPACITY;
+            share_cursor[r] = head - SHARE_RING_CAPACITY;
+        }
+        for (; share_cursor[r] < head && ok; share_cursor[r]++) {
+            if (ring->read(share_cursor[r], lits, &size)) import_clause(lits, size);
+            else stats.dropped++;
+        }
+    }
+}
+
+/**
+ * Searches until a model or a refutation is found, or until the conflict budget of the
+ * current restart is used up, in which case it backtracks to level 0 and returns CDCL_UNKNOWN.
+*/
+int CdclSolver::search(uint64_t conflict_budget, const vector<uint32_t> &assumptions) {
+    TRACE_SCOPE("cdcl search");
+    uint64_t conflicts = 0;
+    vector<uint32_t> learnt;
+
+    for (;;) {
+        uint32_t confl = propagate();
+
+        if (confl != CREF_NONE) {
+            stats.conflicts++;
+            count_conflict();
+            conflicts++;
+            if (decision_level() == 0) {
+                ok = false;
+                if (proof != NULL) proof->add(NULL, 0);
+                return CDCL_UNSAT;
+            }
+
+            int btlevel;
+            uint32_t lbd;
+            analyze(confl, learnt, &btlevel, &lbd);
+            cancel_until(btlevel);
+            if (proof != NULL) proof->add(learnt);
+
+            if (learnt.size() == 1) {
+                enqueue(learnt[0], CREF_NONE);
+            } else {
+                uint32_t cref = add_learnt(learnt, lbd);
+                enqueue(learnt[0], cref);
+            }
+            stats.learnt++;
+            export_clause(learnt);
+
+            var_inc *= 1 / 0.95;
+        } else {
+            if (conflicts >= conflict_budget || (stop != NULL && stop->load(memory_order_relaxed)) ||
+                (budget != NULL && budget->exhausted(stats.decisions - solve_decisions, stats.propagations - solve_propagations))) {
+                cancel_until(0);
+                return CDCL_UNKNOWN;
+            }
+
+            // Assumptions are decided first, one decision level each
+            uint32_t next = LIT_UNDEF;
+            while (decision_level() < (int)assumptions.size()) {
+                uint32_t a = assumptions[decision_level()];
+                if (vals[a] == 1) {
+                    // Already true, opens an empty decision level
+                    trail_lim.push_back(trail.size());
+                } else if (vals[a] == -1) {
+                    analyze_final(a);
+                    return CDCL_UNSAT;
+                } else {
+                    next = a;
+                    break;
+                }
+            }
+
+            if (next == LIT_UNDEF) next = pick_branch();
+            if (next == LIT_UNDEF) {
+                // All variables assigned without conflict
+                model.assign(vals.size() / 2, 0);
+                for (uint32_t v = 1; v < model.size(); v++)
+                    model[v] = vals[mk_lit(v, true)];
+                return CDCL_SAT;
+            }
+
+            stats.decisions++;
+            trail_lim.push_back(trail.size());
+            note_depth(decision_level());
+            enqueue(next, CREF_NONE);
+        }
+    }
+}
+
+/**
+ * Determines satisfiability under a list of assumed literals.
+ * Learnt clauses, activities and saved phases are kept between calls.
+ * If the formula is unsatisfiable under the assumptions, failed() holds the assumptions
+ * involved in the refutation; it is empty if the formula itself is unsatisfiable.
+*/
+int CdclSolver::solve(const vector<uint32_t> &assumptions) {
+    failed_lits.clear();
+    model.clear();
+    // Leaves an enumeration in progress
+    model_on_trail = false;
+    cancel_until(0);
+    solve_decisions = stats.decisions;
+    solve_propagations = stats.propagations;
+    if (!ok) {
+        if (proof != NULL) proof->add(NULL, 0);
+        return CDCL_UNSAT;
+    }
+
+    uint32_t max_var = 0;
+    for (uint32_t lit : assumptions) max_var = max(max_var, lit_var(lit));
+    ensure_vars(max_var);
+
+    for (uint64_t restart = 0;; restart++) {
+        if (stop != NULL && stop->load(memory_order_relaxed)) return CDCL_UNKNOWN;
+        if (budget != NULL && budget->stopped()) {
+            if (checkpoint != NULL) save_state();
+            return CDCL_UNKNOWN;
+        }
+
+        // Level 0 is the safe point for exchanging and deleting clauses
+        import_shared();
+        if (!ok) return CDCL_UNSAT;
+        if (num_learnts > max_learnts) reduce_db();
+        report_memory();
+        if (checkpoint != NULL && checkpoint->requested()) save_state();
+
+        int res = search(luby(restart) * restart_base, assumptions);
+        if (res != CDCL_UNKNOWN) {
+            cancel_until(0);
+            return res;
+        }
+        stats.restarts++;
+        count_restart();
+    }
+}
+
+/**
+ * Restricts model enumeration to the given variables, which are then always branched on
+ * before any other variable. An empty list projects onto every variable.
+*/
+void CdclSolver::set_projection(const vector<uint32_t> &vars) {
+    uint32_t max_var = 0;
+    for (uint32_t v : vars) max_var = max(max_var, v);
+    ensure_vars(max_var);
+
+    priority.assign(priority.size(), vars.empty() ? 1 : 0);
+    for (uint32_t v : vars) priority[v] = 1;
+    for (int i = (int)heap.size() / 2 - 1; i >= 0; i--)
+        heap_down(i);
+}
+
+/**
+ * Blocks the projection of the model on the trail and backtracks just far enough to continue.
+ * Projected variables are decided first, so their values follow from the projected decisions
+ * alone, and the negated decisions form the blocking clause. Its literal of the last decision
+ * is asserted one level below, which flips that decision like a learnt clause would.
+ * Returns false if the blocking clause is empty, i.e. every projected model has been found.
+*/
+bool CdclSolver::block_model() {
+    int k = projected_levels;
+    if (k == 0) return false;
+
+    // Highest level first, so the two watched literals are the asserting one and the next highest
+    vector<uint32_t> lits;
+    for (int l = k; l >= 1; l--)
+        lits.push_back(trail[trail_lim[l-1]] ^ 1);
+
+    cancel_until(k - 1);
+    if (lits.size() == 1) {
+        enqueue(lits[0], CREF_NONE);
+        return true;
+    }
+
+    uint32_t *copy = new uint32_t[lits.size()];
+    for (size_t i = 0; i < lits.size(); i++) copy[i] = lits[i];
+    uint32_t cref = attach_clause(copy, lits.size(), false);
+    clauses[cref].owned = true;
+    enqueue(lits[0], cref);
+    return true;
+}
+
+/**
+ * Finds the next model whose projection differs from all models found before, continuing
+ * from the trail of the previous model instead of restarting. Clauses learnt along the way
+ * stay valid, as the blocking clauses are kept as original clauses.
+ * Returns CDCL_UNSAT once the models are exhausted.
+*/
+int CdclSolver::next_model() {
+    model.clear();
+    if (!ok) return CDCL_UNSAT;
+    if (model_on_trail) {
+        model_on_trail = false;
+        if (!block_model()) {
+            ok = false;
+            return CDCL_UNSAT;
+        }
+    }
+
+    for (uint64_t restart = 0;; restart++) {
+        if (stop != NULL && stop->load(memory_order_relaxed)) return CDCL_UNKNOWN;
+        if (budget != NULL && budget->stopped()) return CDCL_UNKNOWN;
+
+        if (decision_level() == 0 && num_learnts > max_learnts) reduce_db();
+        report_memory();
+
+        int res = search(luby(restart) * restart_base, vector<uint32_t>());
+        if (res == CDCL_SAT) {
+            projected_levels = 0;
+            while (projected_levels < decision_level() && priority[lit_var(trail[trail_lim[projected_levels]])])
+                projected_levels++;
+            model_on_trail = true;
+        }
+        if (res != CDCL_UNKNOWN) return res;
+        stats.restarts++;
+        count_restart();
+    }
+}
+
+/**
+ * Collects the assumptions responsible for assumption a being false, by following the
+ * reasons of its implication back to the decisions, which are all assumptions at this point.
+*/
+void CdclSolver::analyze_final(uint32_t a) {
+    failed_lits.clear();
+    failed_lits.push_back(a);
+    if (decision_level() == 0) return;
+
+    seen[lit_var(a)] = 1;
+    for (size_t i = trail.size(); i > trail_lim[0]; i--) {
+        uint32_t lit = trail[i-1];
+        uint32_t v = lit_var(lit);
+        if (!seen[v]) continue;
+
+        if (reason[v] == CREF_NONE) {
+            failed_lits.push_back(lit);
+        } else {
+            ClauseInfo &c = clauses[reason[v]];
+            for (uint32_t k = 0; k < c.size; k++) {
+                uint32_t u = lit_var(c.lits[k]);
+                if (u != v && level[u] > 0) seen[u] = 1;
+            }
+        }
+        seen[v] = 0;
+    }
+    seen[lit_var(a)] = 0;
+}
+
+bool CdclSolver::is_failed(uint32_t lit) {
+    return find(failed_lits.begin(), failed_lits.end(), lit) != failed_lits.end();
+}
+
+struct CdclRun {
+    const CnfFormula *formula;
+    SharedClauses *shared;
+    SearchBudget *budget;
+    ProofWriter *proof;
+    CheckpointWriter *checkpoint;
+    const checkpoint_state *resumed;
+    uint32_t seed;
+    vector<CdclSolver*> solvers;
+    vector<int> results;
+    atomic<bool> stop{false};
+    atomic<int> winner{-1};
+};
+
+static void cdcl_worker(CdclRun *run, int id) {
+    int res;
+    try {
+        CdclSolver *solver = new CdclSolver(run->formula, run->seed + id, id > 0);
+        run->solvers[id] = solver;
+        solver->stop = &run->stop;
+        solver->budget = run->budget;
+        solver->proof = run->proof;
+        if (run->shared != NULL) solver->set_sharing(run->shared, id);
+        if (run->resumed != NULL) solver->load_state(*run->resumed);
+        solver->checkpoint = run->checkpoint;
+
+        res = solver->solve();
+    } catch (const bad_alloc &) {
+        // The other threads stop at the budget; a solver that could not be built stays NULL
+        run->budget->trip("out of memory");
+        res = CDCL_UNKNOWN;
+    }
+    run->results[id] = res;
+    if (run->solvers[id] != NULL)
+        run->budget->add_work(run->solvers[id]->stats.decisions, run->solvers[id]->stats.propagations);
+    if (res == CDCL_UNKNOWN) return;
+
+    int expected = -1;
+    if (run->winner.compare_exchange_strong(expected, id)) run->stop.store(true);
+}
+
+/**
+ * Determines the satisfiability of a formula with one or more cooperating CDCL threads.
+ * Threads export their short learnt clauses into their own share ring and import the
+ * clauses of the others at every restart. The first thread to finish cancels the rest.
+ * Returns CDCL_UNKNOWN if the budget ran out first. A proof can only be written, and a checkpoint
+ * only be saved or resumed, by a single thread.
+*/
+int cdcl_solve(const CnfFormula &formula, int num_threads, uint32_t seed, SearchBudget *budget, vector<literal> *model, ProofWriter *proof,
+               CheckpointWriter *checkpoint, const checkpoint_state *resumed) {
+    CdclRun run;
+    run.formula = &formula;
+    run.shared = num_threads > 1 ? new SharedClauses(num_threads) : NULL;
+    run.budget = budget;
+    run.proof = num_threads == 1 ? proof : NULL;
+    run.checkpoint = num_threads == 1 ? checkpoint : NULL;
+    run.resumed = num_threads == 1 ? resumed : NULL;
+    run.seed = seed;
+    run.solvers.assign(num_threads, NULL);
+    run.results.assign(num_threads, CDCL_UNKNOWN);
+
+    vector<thread> threads;
+    for (int i = 0; i < num_threads; i++)
+        threads.push_back(thread(cdcl_worker, &run, i));
+    for (thread &t : threads)
+        t.join();
+
+    int w = run.winner.load();
+    cdcl_stats total;
+    for (CdclSolver *solver : run.solvers) {
+        if (solver == NULL) continue;
+        total.decisions += solver->stats.decisions;
+        total.propagations += solver->stats.propagations;
+        total.conflicts += solver->stats.conflicts;
+        total.restarts += solver->stats.restarts;
+        total.learnt += solver->stats.learnt;
+        total.exported += solver->stats.exported;
+        total.imported += solver->stats.imported;
+        total.filtered_size += solver->stats.filtered_size;
+        total.filtered_duplicate += solver->stats.filtered_duplicate;
+        total.dropped += solver->stats.dropped;
+        total.useful += solver->stats.useful;
+    }
+
+    if (w >= 0) cout << "c CDCL: " << num_threads << " threads, thread " << w << " finished first" << endl;
+    else cout << "c CDCL: " << num_threads << " threads, none finished" << endl;
+    cout << "c   decisions " << total.decisions << ", propagations " << total.propagations
+         << ", conflicts " << total.conflicts << ", restarts " << total.restarts << endl;
+    if (run.shared != NULL) {
+        cout << "c   sharing: exported " << total.exported << ", imported " << total.imported
+             << ", useful " << total.useful << ", filtered " << total.filtered_size << " by size, "
+             << total.filtered_duplicate << " duplicates, dropped " << total.dropped << endl;
+    }
+
+    int res = w < 0 ? CDCL_UNKNOWN : run.results[w];
+    if (res == CDCL_SAT) {
+        model->clear();
+        for (uint32_t v = 1; v <= formula.num_vars; v++)
+            model->push_back({v, run.solvers[w]->model_value(v)});
+    }
+
+    for (CdclSolver *solver : run.solvers)
+        delete solver;
+    delete run.shared;
+
+    return res;
+}
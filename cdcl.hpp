@@ -0,0 +1,181 @@
+#ifndef CDCL_H
+#define CDCL_H
+
+#include <unordered_set>
+#include <thread>
+#include "SAT-solver.hpp"
+#include "share_ring.hpp"
+
+class ProofWriter;
+class CheckpointWriter;
+struct checkpoint_state;
+
+// Literals are encoded as 2*var for var and 2*var+1 for its negation
+inline uint32_t mk_lit(uint32_t var, bool positive) { return 2 * var + (positive ? 0 : 1); }
+inline uint32_t lit_var(uint32_t lit) { return lit >> 1; }
+inline bool lit_positive(uint32_t lit) { return (lit & 1) == 0; }
+
+const uint32_t LIT_UNDEF = UINT32_MAX;
+const uint32_t CREF_NONE = UINT32_MAX;
+
+enum cdcl_result {
+    CDCL_UNSAT = 0,
+    CDCL_SAT = 1,
+    CDCL_UNKNOWN = 2
+};
+
+/**
+ * Input clause set in flat form, shared read-only by every solver thread.
+ * Clause i occupies lits[start[i]] .. lits[start[i+1]-1]. Clauses are sorted and free of
+ * duplicate literals; tautologies are dropped.
+*/
+struct CnfFormula {
+    uint32_t num_vars = 0;
+    vector<uint64_t> start;
+    vector<uint32_t> lits;
+    bool has_empty = false;
+    uint32_t num_clauses() const { return start.size() - 1; }
+};
+
+void build_cnf_formula(Clause **clause_set, int n, CnfFormula *formula);
+
+struct ClauseInfo {
+    const uint32_t *lits;
+    uint32_t size;
+    // Positions of the two watched literals
+    uint32_t watch[2];
+    uint32_t lbd;
+    bool learnt;
+    // Literals allocated by the solver rather than taken from the shared formula
+    bool owned;
+    bool imported;
+    bool used;
+    bool deleted;
+};
+
+struct Watcher {
+    uint32_t cref;
+    // Some other literal of the clause; the clause is skipped while it is true
+    uint32_t blocker;
+};
+
+struct cdcl_stats {
+    uint64_t decisions = 0;
+    uint64_t propagations = 0;
+    uint64_t conflicts = 0;
+    uint64_t restarts = 0;
+    uint64_t learnt = 0;
+    uint64_t exported = 0;
+    uint64_t imported = 0;
+    uint64_t filtered_size = 0;
+    uint64_t filtered_duplicate = 0;
+    uint64_t dropped = 0;
+    uint64_t useful = 0;
+};
+
+/**
+ * Conflict-driven clause-learning search over a shared CnfFormula.
+ * Original clauses are watched in place through per-solver watch positions, so the formula itself
+ * is never written. Uses VSIDS branching with phase saving, first-UIP learning with clause
+ * minimization, Luby restarts and LBD-based learnt clause reduction.
+*/
+class CdclSolver {
+    public:
+        CdclSolver(const CnfFormula *formula = NULL, uint32_t seed = 0, bool diversify = false);
+        ~CdclSolver();
+        void set_sharing(SharedClauses *shared, int id);
+        void ensure_vars(uint32_t n);
+        uint32_t num_vars() { return vals.empty() ? 0 : vals.size() / 2 - 1; }
+        bool add_clause(const vector<uint32_t> &lits);
+        int solve(const vector<uint32_t> &assumptions = vector<uint32_t>());
+        bool model_value(uint32_t var);
+        const vector<uint32_t> &failed() { return failed_lits; }
+        bool is_failed(uint32_t lit);
+        void set_projection(const vector<uint32_t> &vars);
+        int next_model();
+        atomic<bool> *stop = NULL;
+        SearchBudget *budget = NULL;
+        // Receives the learnt and deleted clauses as a DRAT proof
+        ProofWriter *proof = NULL;
+        // Receives snapshots of the learnt clauses and heuristics between restarts
+        CheckpointWriter *checkpoint = NULL;
+        void load_state(const checkpoint_state &state);
+        cdcl_stats stats;
+        // Work of the last solve() call, which its budget is charged for
+        uint64_t call_decisions() { return stats.decisions - solve_decisions; }
+        uint64_t call_propagations() { return stats.propagations - solve_propagations; }
+    private:
+        const CnfFormula *formula;
+        bool ok;
+        vector<ClauseInfo> clauses;
+        vector<vector<Watcher>> watches;
+        vector<int8_t> vals;
+        vector<int> level;
+        vector<uint32_t> reason;
+        vector<uint32_t> trail;
+        vector<size_t> trail_lim;
+        size_t qhead = 0;
+        vector<double> activity;
+        double var_inc = 1.0;
+        vector<uint32_t> heap;
+        vector<int> heap_pos;
+        vector<bool> phase;
+        // Projected variables, branched on before all others
+        vector<char> priority;
+        // Set while the trail holds the last model of next_model(), whose first levels decide projected variables
+        bool model_on_trail = false;
+        int projected_levels = 0;
+        vector<char> seen;
+        vector<uint32_t> analyze_clear;
+        vector<uint32_t> level_stamp;
+        uint32_t stamp = 0;
+        vector<int8_t> model;
+        vector<uint32_t> failed_lits;
+        // Counters at the start of the current solve() call; the budget gets the work since then,
+        // so callers making several calls publish each call's work with call_decisions()
+        uint64_t solve_decisions = 0;
+        uint64_t solve_propagations = 0;
+        uint32_t rng;
+        uint64_t restart_base = 100;
+        uint64_t num_learnts = 0;
+        double max_learnts;
+        SharedClauses *shared = NULL;
+        int share_id = 0;
+        vector<uint64_t> share_cursor;
+        unordered_set<uint64_t> shared_hashes;
+        // Bytes of the clause database, and the part of them added to the memory accounting
+        uint64_t memory_bytes = 0;
+        uint64_t memory_reported = 0;
+
+        uint32_t next_random();
+        int decision_level() { return trail_lim.size(); }
+        void enqueue(uint32_t lit, uint32_t from);
+        uint32_t attach_clause(const uint32_t *lits, uint32_t size, bool learnt);
+        uint32_t add_learnt(const vector<uint32_t> &lits, uint32_t lbd);
+        uint32_t propagate();
+        void analyze(uint32_t confl, vector<uint32_t> &out_learnt, int *out_btlevel, uint32_t *out_lbd);
+        void cancel_until(int lvl);
+        uint32_t pick_branch();
+        bool block_model();
+        bool heap_above(uint32_t a, uint32_t b) {
+            return priority[a] != priority[b] ? priority[a] > priority[b] : activity[a] > activity[b];
+        }
+        void bump_var(uint32_t var);
+        void heap_insert(uint32_t var);
+        uint32_t heap_pop();
+        void heap_up(int i);
+        void heap_down(int i);
+        void reduce_db();
+        void report_memory();
+        void save_state();
+        void export_clause(const vector<uint32_t> &lits);
+        void import_clause(const uint32_t *lits, uint32_t size);
+        void import_shared();
+        void analyze_final(uint32_t a);
+        int search(uint64_t conflict_budget, const vector<uint32_t> &assumptions);
+};
+
+int cdcl_solve(const CnfFormula &formula, int num_threads, uint32_t seed, SearchBudget *budget, vector<literal> *model, ProofWriter *proof = NULL,
+               CheckpointWriter *checkpoint = NULL, const checkpoint_state *resumed = NULL);
+
+#endif
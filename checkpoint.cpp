@@ -0,0 +1,195 @@
+#include <cstdio>
+#include "checkpoint.hpp"
+
+static const char CHECKPOINT_MAGIC[8] = {'S', 'A', 'T', 'C', 'K', 'P', 'T', '1'};
+
+/**
+ * FNV-1a hash of a clause set as read, to recognize the formula a checkpoint belongs to.
+*/
+uint64_t hash_clause_set(Clause **clause_set, int n) {
+    uint64_t hash = 14695981039346656037ull;
+    auto mix = [&](uint32_t value) {
+        for (int i = 0; i < 4; i++) {
+            hash ^= (value >> (8 * i)) & 0xff;
+            hash *= 1099511628211ull;
+        }
+    };
+    for (int i = 0; i < n; i++) {
+        mix(clause_set[i]->n);
+        for (int j = 0; j < clause_set[i]->n; j++)
+            mix(mk_lit(clause_set[i]->literals[j].var, clause_set[i]->literals[j].positive));
+    }
+    return hash;
+}
+
+template <class T>
+static void put(ofstream &out, T value) {
+    out.write((const char*)&value, sizeof(T));
+}
+
+template <class T>
+static bool get(ifstream &in, T *value) {
+    return (bool)in.read((char*)value, sizeof(T));
+}
+
+static void put_clauses(ofstream &out, const vector<vector<uint32_t>> &clauses) {
+    put<uint32_t>(out, clauses.size());
+    for (const vector<uint32_t> &clause : clauses) {
+        put<uint32_t>(out, clause.size());
+        out.write((const char*)clause.data(), clause.size() * sizeof(uint32_t));
+    }
+}
+
+static bool get_clauses(ifstream &in, vector<vector<uint32_t>> *clauses) {
+    uint32_t count;
+    if (!get(in, &count)) return false;
+    clauses->clear();
+    for (uint32_t i = 0; i < count; i++) {
+        uint32_t size;
+        if (!get(in, &size) || size > (1u << 28)) return false;
+        vector<uint32_t> clause(size);
+        if (!in.read((char*)clause.data(), size * sizeof(uint32_t))) return false;
+        clauses->push_back(move(clause));
+    }
+    return true;
+}
+
+/**
+ * Writes a checkpoint in the native byte order: the magic, the kind, the formula hash and the
+ * counters, then for the sequent search the cubes, and for CDCL the number of variables, the
+ * activity increment, the activities, the phases as a bit set, and the learnt clauses with their LBD.
+ * Clauses and cubes are a count followed by their literal codes.
+ * The file is written next to the target and renamed over it.
+*/
+bool write_checkpoint(string path, const checkpoint_state &state) {
+    string temp = path + ".tmp";
+    ofstream out(temp, ios::binary | ios::trunc);
+    if (!out) return false;
+
+    out.write(CHECKPOINT_MAGIC, sizeof(CHECKPOINT_MAGIC));
+    put<uint32_t>(out, state.kind);
+    put<uint64_t>(out, state.formula_hash);
+    put<uint64_t>(out, state.decisions);
+    put<uint64_t>(out, state.propagations);
+    put<double>(out, state.seconds);
+
+    if (state.kind == CHECKPOINT_SEQUENT) {
+        put_clauses(out, state.cubes);
+    } else {
+        put<uint32_t>(out, state.activity.size());
+        put<double>(out, state.var_inc);
+        out.write((const char*)state.activity.data(), state.activity.size() * sizeof(double));
+        vector<uint8_t> bits((state.phase.size() + 7) / 8, 0);
+        for (size_t v = 0; v < state.phase.size(); v++)
+            if (state.phase[v]) bits[v / 8] |= 1 << (v % 8);
+        out.write((const char*)bits.data(), bits.size());
+        put_clauses(out, state.learnts);
+        out.write((const char*)state.lbds.data(), state.lbds.size() * sizeof(uint32_t));
+    }
+
+    out.close();
+    if (!out) {
+        remove(temp.c_str());
+        return false;
+    }
+    return rename(temp.c_str(), path.c_str()) == 0;
+}
+
+/**
+ * Reads a checkpoint. Returns 1 on success, 0 if there is no file, and -1 if it is not a valid checkpoint.
+*/
+int read_checkpoint(string path, checkpoint_state *state) {
+    ifstream in(path, ios::binary);
+    if (!in) return 0;
+
+    char magic[sizeof(CHECKPOINT_MAGIC)];
+    if (!in.read(magic, sizeof(magic)) || memcmp(magic, CHECKPOINT_MAGIC, sizeof(magic)) != 0) return -1;
+    if (!get(in, &state->kind) || !get(in, &state->formula_hash) || !get(in, &state->decisions) ||
+        !get(in, &state->propagations) || !get(in, &state->seconds)) return -1;
+
+    if (state->kind == CHECKPOINT_SEQUENT) return get_clauses(in, &state->cubes) ? 1 : -1;
+    if (state->kind != CHECKPOINT_CDCL) return -1;
+
+    uint32_t num_vars;
+    if (!get(in, &num_vars) || num_vars > (1u << 30) || !get(in, &state->var_inc)) return -1;
+    state->activity.resize(num_vars);
+    if (!in.read((char*)state->activity.data(), num_vars * sizeof(double))) return -1;
+    vector<uint8_t> bits((num_vars + 7) / 8);
+    if (!in.read((char*)bits.data(), bits.size())) return -1;
+    state->phase.assign(num_vars, false);
+    for (uint32_t v = 0; v < num_vars; v++) state->phase[v] = bits[v / 8] >> (v % 8) & 1;
+    if (!get_clauses(in, &state->learnts)) return -1;
+    state->lbds.resize(state->learnts.size());
+    if (!in.read((char*)state->lbds.data(), state->lbds.size() * sizeof(uint32_t))) return -1;
+    return 1;
+}
+
+CheckpointWriter::CheckpointWriter(string path, double interval, uint64_t formula_hash, SearchBudget *budget,
+                                   const checkpoint_state *resumed) {
+    this->path = path;
+    this->interval = interval;
+    this->formula_hash = formula_hash;
+    this->budget = budget;
+    if (resumed != NULL) {
+        previous.decisions = resumed->decisions;
+        previous.propagations = resumed->propagations;
+        previous.seconds = resumed->seconds;
+    }
+    writer = thread(&CheckpointWriter::run, this);
+}
+
+CheckpointWriter::~CheckpointWriter() {
+    {
+        lock_guard<mutex> guard(lock);
+        done = true;
+        wake.notify_all();
+    }
+    writer.join();
+    if (discarded) remove(path.c_str());
+}
+
+/**
+ * Hands a snapshot of the search over to the writer thread, replacing one it has not written yet.
+*/
+void CheckpointWriter::save(checkpoint_state &&state) {
+    state.formula_hash = formula_hash;
+    state.decisions = previous.decisions + budget->total_decisions();
+    state.propagations = previous.propagations + budget->total_propagations();
+    state.seconds = previous.seconds + budget->elapsed();
+
+    lock_guard<mutex> guard(lock);
+    request.store(false);
+    if (discarded) return;
+    pending = move(state);
+    has_pending = true;
+    wake.notify_all();
+}
+
+void CheckpointWriter::discard() {
+    lock_guard<mutex> guard(lock);
+    discarded = true;
+    has_pending = false;
+}
+
+void CheckpointWriter::run() {
+    double next = interval;
+    unique_lock<mutex> guard(lock);
+    for (;;) {
+        wake.wait_for(guard, chrono::milliseconds(100), [this] { return done || has_pending; });
+        if (has_pending) {
+            // Writes without the lock, so the search can hand over the next snapshot meanwhile
+            checkpoint_state state = move(pending);
+            has_pending = false;
+            guard.unlock();
+            bool written = write_checkpoint(path, state);
+            guard.lock();
+            if (!written) cerr << "Error: cannot write the checkpoint " << path << endl;
+            continue;
+        }
+        if (done) break;
+        if (budget->elapsed() >= next) {
+            request.store(true);
+            next = budget->elapsed() + interval;
+        }
+    }
+}
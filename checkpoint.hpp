@@ -0,0 +1,75 @@
+#ifndef CHECKPOINT_H
+#define CHECKPOINT_H
+
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include "cdcl.hpp"
+
+enum checkpoint_kind {
+    CHECKPOINT_SEQUENT = 1,
+    CHECKPOINT_CDCL = 2
+};
+
+/**
+ * State of an interrupted search, enough to continue it in another process.
+ * The sequent search saves its open branches, each as the cube of literals leading to it.
+ * The CDCL search saves its learnt clauses with their LBD, the units it derived, and its
+ * variable activities and saved phases; it resumes with a restart.
+ * Literals are literal codes, see mk_lit(). Decisions, propagations and seconds add up
+ * the work of all the runs so far.
+*/
+struct checkpoint_state {
+    uint32_t kind = 0;
+    uint64_t formula_hash = 0;
+    uint64_t decisions = 0;
+    uint64_t propagations = 0;
+    double seconds = 0;
+    // CHECKPOINT_SEQUENT
+    vector<vector<uint32_t>> cubes;
+    // CHECKPOINT_CDCL
+    vector<vector<uint32_t>> learnts;
+    vector<uint32_t> lbds;
+    double var_inc = 1.0;
+    vector<double> activity;
+    vector<bool> phase;
+};
+
+uint64_t hash_clause_set(Clause **clause_set, int n);
+bool write_checkpoint(string path, const checkpoint_state &state);
+int read_checkpoint(string path, checkpoint_state *state);
+
+/**
+ * Writes checkpoints of a search in the background. Every interval seconds it raises
+ * requested(), which the search polls at its safe points; the search then hands a snapshot to
+ * save(), and a writer thread stores it, through a temporary file renamed over the old
+ * checkpoint so that a crash never leaves a torn file. The search only pays for copying its
+ * state. The counters of the previous runs are added to those of the budget.
+ * After discard(), for a search that ended with an answer, the checkpoint file is deleted instead.
+*/
+class CheckpointWriter {
+    public:
+        CheckpointWriter(string path, double interval, uint64_t formula_hash, SearchBudget *budget, const checkpoint_state *resumed);
+        ~CheckpointWriter();
+        bool requested() { return request.load(memory_order_relaxed); }
+        void save(checkpoint_state &&state);
+        void discard();
+    private:
+        string path;
+        double interval;
+        uint64_t formula_hash;
+        SearchBudget *budget;
+        checkpoint_state previous;
+        atomic<bool> request{false};
+        mutex lock;
+        condition_variable wake;
+        bool has_pending = false;
+        bool done = false;
+        bool discarded = false;
+        checkpoint_state pending;
+        thread writer;
+
+        void run();
+};
+
+#endif
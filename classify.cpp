@@ -0,0 +1,306 @@
+#include "classify.hpp"
+
+/**
+ * Encodes a literal as an index into a dense array of 2 * num_vars entries.
+ * The negation of a literal code is obtained by flipping the lowest bit.
+*/
+static inline int lit_code(literal lit) {
+    return 2 * (int)(lit.var - 1) + (lit.positive ? 0 : 1);
+}
+
+const char *formula_class_name(formula_class fc) {
+    switch (fc) {
+        case FORMULA_2SAT: return "2-SAT";
+        case FORMULA_HORN: return "Horn";
+        case FORMULA_RENAMABLE_HORN: return "renamable Horn";
+        default: return "general";
+    }
+}
+
+uint32_t max_var_of(Clause **clause_set, int n) {
+    uint32_t max_var = 0;
+    for (int i = 0; i < n; i++)
+        for (int j = 0; j < clause_set[i]->n; j++)
+            if (clause_set[i]->literals[j].var > max_var) max_var = clause_set[i]->literals[j].var;
+    return max_var;
+}
+
+/**
+ * Determines which polynomial class, if any, the clause set belongs to.
+ * The classes are tested in order of decreasing cost-effectiveness: 2-SAT, Horn, renamable Horn.
+ * For renamable Horn formulas, renaming[v] is set to true for each variable v whose polarity
+ * has to be flipped for the formula to become Horn.
+*/
+formula_class classify_clause_set(Clause **clause_set, int n, uint32_t max_var, vector<bool> *renaming) {
+    bool is_2sat = true;
+    bool is_horn = true;
+    long total = 0;
+
+    for (int i = 0; i < n; i++) {
+        int k = clause_set[i]->n;
+        if (k > 2) is_2sat = false;
+
+        int positives = 0;
+        for (int j = 0; j < k; j++)
+            if (clause_set[i]->literals[j].positive) positives++;
+        if (positives > 1) is_horn = false;
+
+        total += k;
+    }
+
+    if (is_2sat) return FORMULA_2SAT;
+    if (is_horn) return FORMULA_HORN;
+
+    // A renaming r makes the formula Horn iff no clause keeps two positive literals.
+    // Literal l over variable v is positive after renaming iff l.positive != r(v), that is iff
+    // its code is false under r. At most one code per clause may be false, which a sequential
+    // counter expresses in 2-SAT clauses with one auxiliary variable per literal:
+    // s_j is true once one of the first j codes of the clause is false.
+    vector<int> lits;
+    lits.reserve(6 * total);
+    uint32_t num_vars = max_var;
+    for (int i = 0; i < n; i++) {
+        Clause *cl = clause_set[i];
+        int prev = -1;
+        for (int j = 0; j < cl->n; j++) {
+            int code = lit_code(cl->literals[j]);
+            if (prev >= 0) {
+                // The counter is already set, this code must stay true
+                lits.push_back(code);
+                lits.push_back(prev ^ 1);
+            }
+            if (j == cl->n - 1) break;
+
+            int s = 2 * num_vars++;
+            lits.push_back(code);
+            lits.push_back(s);
+            if (prev >= 0) {
+                lits.push_back(prev ^ 1);
+                lits.push_back(s);
+            }
+            prev = s;
+        }
+    }
+
+    vector<bool> assignment;
+    if (!two_sat_solve(num_vars, lits, &assignment)) return FORMULA_GENERAL;
+
+    renaming->assign(max_var + 1, false);
+    for (uint32_t v = 1; v <= max_var; v++)
+        (*renaming)[v] = assignment[v - 1];
+
+    return FORMULA_RENAMABLE_HORN;
+}
+
+/**
+ * Solves a 2-SAT instance given as a flat list of literal code pairs.
+ * Builds the implication graph (not a -> b, not b -> a for each clause (a v b)) and computes its
+ * strongly connected components with an iterative version of Tarjan's algorithm.
+ * The formula is unsatisfiable iff some variable shares a component with its negation.
+ * Otherwise assignment[v-1] is set to a satisfying value for variable v.
+*/
+bool two_sat_solve(uint32_t num_vars, const vector<int> &lits, vector<bool> *assignment) {
+    int num_nodes = 2 * num_vars;
+    size_t m = lits.size() / 2;
+
+    // Implication graph in compressed sparse row form
+    vector<int> start(num_nodes + 1, 0);
+    for (size_t i = 0; i < m; i++) {
+        start[(lits[2*i] ^ 1) + 1]++;
+        start[(lits[2*i+1] ^ 1) + 1]++;
+    }
+    for (int v = 0; v < num_nodes; v++) start[v+1] += start[v];
+
+    vector<int> adj(2 * m);
+    vector<int> fill(start.begin(), start.end() - 1);
+    for (size_t i = 0; i < m; i++) {
+        int a = lits[2*i];
+        int b = lits[2*i+1];
+        adj[fill[a ^ 1]++] = b;
+        adj[fill[b ^ 1]++] = a;
+    }
+
+    vector<int> index(num_nodes, -1);
+    vector<int> low(num_nodes, 0);
+    vector<int> comp(num_nodes, -1);
+    vector<int> scc_stack;
+    vector<pair<int, int>> call_stack;
+    int next_index = 0;
+    int num_comps = 0;
+
+    for (int root = 0; root < num_nodes; root++) {
+        if (index[root] != -1) continue;
+
+        call_stack.push_back({root, start[root]});
+        index[root] = low[root] = next_index++;
+        scc_stack.push_back(root);
+
+        while (!call_stack.empty()) {
+            int node = call_stack.back().first;
+            int &edge = call_stack.back().second;
+
+            if (edge < start[node+1]) {
+                int next = adj[edge++];
+                if (index[next] == -1) {
+                    index[next] = low[next] = next_index++;
+                    scc_stack.push_back(next);
+                    call_stack.push_back({next, start[next]});
+                } else if (comp[next] == -1 && index[next] < low[node]) {
+                    // Back edge to a node still on the component stack
+                    low[node] = index[next];
+                }
+                continue;
+            }
+
+            // All successors visited
+            if (low[node] == index[node]) {
+                int w;
+                do {
+                    w = scc_stack.back();
+                    scc_stack.pop_back();
+                    comp[w] = num_comps;
+                } while (w != node);
+                num_comps++;
+            }
+            call_stack.pop_back();
+            if (!call_stack.empty()) {
+                int parent = call_stack.back().first;
+                if (low[node] < low[parent]) low[parent] = low[node];
+            }
+        }
+    }
+
+    // Tarjan numbers components in reverse topological order,
+    // so a literal is true iff its component comes before its negation's.
+    assignment->assign(num_vars, false);
+    for (uint32_t v = 0; v < num_vars; v++) {
+        if (comp[2*v] == comp[2*v+1]) return false;
+        (*assignment)[v] = comp[2*v] < comp[2*v+1];
+    }
+
+    return true;
+}
+
+/**
+ * Solves a clause set in which every clause has at most two literals.
+*/
+bool solve_2sat(Clause **clause_set, int n, uint32_t max_var, vector<literal> *model) {
+    vector<int> lits;
+    lits.reserve(2 * n);
+
+    for (int i = 0; i < n; i++) {
+        Clause *cl = clause_set[i];
+        // Empty clause
+        if (cl->n == 0) return false;
+        lits.push_back(lit_code(cl->literals[0]));
+        // A unit clause (a) is encoded as (a v a)
+        lits.push_back(lit_code(cl->literals[cl->n - 1]));
+    }
+
+    vector<bool> assignment;
+    if (!two_sat_solve(max_var, lits, &assignment)) return false;
+
+    model->clear();
+    for (uint32_t v = 1; v <= max_var; v++)
+        model->push_back({v, assignment[v - 1]});
+
+    return true;
+}
+
+/**
+ * Solves a Horn clause set by computing its minimal model with linear-time forward chaining.
+ * Each clause keeps a counter of negative literals whose variable is not yet true;
+ * once it drops to zero the clause forces its positive literal, or is falsified if it has none.
+ * If a renaming is given, literals over renamed variables are flipped on the fly,
+ * and the minimal model is flipped back afterwards.
+*/
+bool solve_horn(Clause **clause_set, int n, uint32_t max_var, const vector<bool> *renaming, vector<literal> *model) {
+    vector<int> counter(n, 0);
+    vector<uint32_t> head(n, 0);
+    vector<int> occ_start(max_var + 2, 0);
+
+    for (int i = 0; i < n; i++) {
+        Clause *cl = clause_set[i];
+        for (int j = 0; j < cl->n; j++) {
+            literal lit = cl->literals[j];
+            bool positive = lit.positive != (renaming != NULL && (*renaming)[lit.var]);
+            if (positive) {
+                head[i] = lit.var;
+            } else {
+                counter[i]++;
+                occ_start[lit.var + 1]++;
+            }
+        }
+    }
+    for (uint32_t v = 0; v <= max_var; v++) occ_start[v+1] += occ_start[v];
+
+    // Clauses indexed by the variables occurring negatively in them
+    vector<int> occ(occ_start[max_var + 1]);
+    vector<int> fill(occ_start.begin(), occ_start.end() - 1);
+    for (int i = 0; i < n; i++) {
+        Clause *cl = clause_set[i];
+        for (int j = 0; j < cl->n; j++) {
+            literal lit = cl->literals[j];
+            bool positive = lit.positive != (renaming != NULL && (*renaming)[lit.var]);
+            if (!positive) occ[fill[lit.var]++] = i;
+        }
+    }
+
+    vector<bool> value(max_var + 1, false);
+    vector<uint32_t> queue;
+    queue.reserve(max_var);
+
+    for (int i = 0; i < n; i++) {
+        if (counter[i] != 0) continue;
+        // Goal clause with all premises satisfied
+        if (head[i] == 0) return false;
+        if (!value[head[i]]) {
+            value[head[i]] = true;
+            queue.push_back(head[i]);
+        }
+    }
+
+    for (size_t q = 0; q < queue.size(); q++) {
+        uint32_t var = queue[q];
+        for (int k = occ_start[var]; k < occ_start[var+1]; k++) {
+            int i = occ[k];
+            if (--counter[i] != 0) continue;
+            if (head[i] == 0) return false;
+            if (!value[head[i]]) {
+                value[head[i]] = true;
+                queue.push_back(head[i]);
+            }
+        }
+    }
+
+    model->clear();
+    for (uint32_t v = 1; v <= max_var; v++) {
+        bool val = value[v] != (renaming != NULL && (*renaming)[v]);
+        model->push_back({v, val});
+    }
+
+    return true;
+}
+
+/**
+ * Routes 2-SAT, Horn and renamable Horn clause sets to their polynomial algorithms.
+ * If the formula was handled, stores the answer and its model and frees the clause set.
+ * Returns false, leaving the clause set untouched, for formulas needing the general search.
+*/
+bool solve_fast_path(Clause **clause_set, int n, bool *res, vector<literal> *model) {
+    uint32_t max_var = max_var_of(clause_set, n);
+    vector<bool> renaming;
+    formula_class fc = classify_clause_set(clause_set, n, max_var, &renaming);
+
+    if (fc == FORMULA_GENERAL) return false;
+
+    cout << "c Formula class: " << formula_class_name(fc) << endl;
+
+    if (fc == FORMULA_2SAT)
+        *res = solve_2sat(clause_set, n, max_var, model);
+    else
+        *res = solve_horn(clause_set, n, max_var, fc == FORMULA_RENAMABLE_HORN ? &renaming : NULL, model);
+
+    free_clause_set(clause_set, n);
+    return true;
+}
@@ -0,0 +1,25 @@
+#ifndef CLASSIFY_H
+#define CLASSIFY_H
+
+#include "SAT-solver.hpp"
+
+enum formula_class {
+    FORMULA_GENERAL,
+    FORMULA_2SAT,
+    FORMULA_HORN,
+    FORMULA_RENAMABLE_HORN
+};
+
+const char *formula_class_name(formula_class fc);
+
+uint32_t max_var_of(Clause **clause_set, int n);
+
+formula_class classify_clause_set(Clause **clause_set, int n, uint32_t max_var, vector<bool> *renaming);
+
+bool two_sat_solve(uint32_t num_vars, const vector<int> &lits, vector<bool> *assignment);
+bool solve_2sat(Clause **clause_set, int n, uint32_t max_var, vector<literal> *model);
+bool solve_horn(Clause **clause_set, int n, uint32_t max_var, const vector<bool> *renaming, vector<literal> *model);
+
+bool solve_fast_path(Clause **clause_set, int n, bool *res, vector<literal> *model);
+
+#endif
@@ -0,0 +1,169 @@
+#include <algorithm>
+#include "core.hpp"
+
+CoreExtractor::CoreExtractor(Clause **clause_set, int n, SearchBudget *budget) {
+    this->n = n;
+    uint32_t num_vars = 0;
+    for (int i = 0; i < n; i++)
+        for (int j = 0; j < clause_set[i]->n; j++)
+            num_vars = max(num_vars, clause_set[i]->literals[j].var);
+    first_selector = num_vars + 1;
+    solver.ensure_vars(num_vars + n);
+    solver.budget = budget;
+
+    for (int i = 0; i < n; i++) {
+        vector<uint32_t> lits;
+        for (int j = 0; j < clause_set[i]->n; j++)
+            lits.push_back(mk_lit(clause_set[i]->literals[j].var, clause_set[i]->literals[j].positive));
+        lits.push_back(selector(i) ^ 1);
+        solver.add_clause(lits);
+    }
+}
+
+/**
+ * Solves with only the given clauses enabled. If they are unsatisfiable,
+ * core receives the enabled clauses used in the refutation, in increasing order.
+*/
+int CoreExtractor::solve_with(const vector<int> &clauses, vector<int> *core) {
+    vector<uint32_t> assumptions;
+    for (int i : clauses) assumptions.push_back(selector(i));
+
+    calls++;
+    int res = solver.solve(assumptions);
+    if (res != CDCL_UNSAT) return res;
+
+    core->clear();
+    for (uint32_t lit : solver.failed())
+        core->push_back(lit_var(lit) - first_selector);
+    sort(core->begin(), core->end());
+    return res;
+}
+
+/**
+ * Permanently removes a clause, which then no longer takes part in any call.
+*/
+void CoreExtractor::disable(int i) {
+    solver.add_clause(vector<uint32_t>(1, selector(i) ^ 1));
+}
+
+/**
+ * Finds an unsatisfiable subset of the clauses. Returns CDCL_SAT if the clause set is satisfiable.
+*/
+int CoreExtractor::find_core(vector<int> *core) {
+    vector<int> all(n);
+    for (int i = 0; i < n; i++) all[i] = i;
+
+    int res = solve_with(all, core);
+    if (res == CDCL_UNSAT) {
+        // Clauses outside the core are never needed again
+        size_t k = 0;
+        for (int i = 0; i < n; i++) {
+            if (k < core->size() && (*core)[k] == i) k++;
+            else disable(i);
+        }
+    }
+    return res;
+}
+
+/**
+ * Gives the model of the last satisfiable call over the variables of the clauses, without the selectors.
+*/
+void CoreExtractor::model(vector<literal> *model) {
+    model->clear();
+    for (uint32_t v = 1; v < first_selector; v++) model->push_back({v, solver.model_value(v)});
+}
+
+/**
+ * Shrinks a core to a minimal unsatisfiable subset by deletion: each clause is dropped in turn,
+ * and if the rest is still unsatisfiable, the core shrinks to the refutation of that call,
+ * and every clause left out is disabled for good. Otherwise the clause is necessary.
+ * Returns false if the budget ran out first, leaving an unsatisfiable but possibly non-minimal core.
+*/
+bool CoreExtractor::minimize(vector<int> *core) {
+    vector<int> necessary;
+    vector<int> candidates = *core;
+
+    while (!candidates.empty()) {
+        int i = candidates.back();
+        candidates.pop_back();
+
+        vector<int> rest = necessary;
+        rest.insert(rest.end(), candidates.begin(), candidates.end());
+
+        vector<int> refutation;
+        int res = solve_with(rest, &refutation);
+        if (res == CDCL_UNKNOWN) {
+            *core = necessary;
+            core->insert(core->end(), candidates.begin(), candidates.end());
+            core->push_back(i);
+            sort(core->begin(), core->end());
+            return false;
+        }
+
+        if (res == CDCL_SAT) {
+            necessary.push_back(i);
+            continue;
+        }
+
+        // Keeps only the candidates used in the refutation
+        disable(i);
+        vector<int> kept;
+        for (int c : candidates) {
+            if (binary_search(refutation.begin(), refutation.end(), c)) kept.push_back(c);
+            else disable(c);
+        }
+        candidates = kept;
+    }
+
+    sort(necessary.begin(), necessary.end());
+    *core = necessary;
+    return true;
+}
+
+/**
+ * Decides a clause set and, if it is unsatisfiable, prints the indexes (1-based, in input order)
+ * of an unsatisfiable subset of its clauses as a 'v' line, minimized if asked.
+ * If it is satisfiable, the model over variables 1 .. num_vars is verified and printed instead.
+ * Takes ownership of the clause set.
+*/
+int extract_core(Clause **clause_set, int n, uint32_t num_vars, bool minimize, SearchBudget *budget) {
+    CoreExtractor extractor(clause_set, n, budget);
+    CnfFormula original;
+    build_cnf_formula(clause_set, n, &original);
+    free_clause_set(clause_set, n);
+
+    vector<int> core;
+    int res = extractor.find_core(&core);
+    if (res == CDCL_SAT) {
+        vector<literal> model;
+        extractor.model(&model);
+        if (!check_model(original, num_vars, &model)) {
+            cout << "s UNKNOWN" << endl;
+            return CDCL_UNKNOWN;
+        }
+        cout << "s SATISFIABLE" << endl;
+        print_model(model);
+        return res;
+    }
+    if (res == CDCL_UNKNOWN) {
+        cout << "c Stopped: " << budget->reason() << " after " << budget->elapsed() << " s" << endl;
+        cout << "s UNKNOWN" << endl;
+        return res;
+    }
+
+    cout << "c Unsatisfiable core: " << core.size() << " of " << n << " clauses" << endl;
+    if (minimize) {
+        if (extractor.minimize(&core)) {
+            cout << "c Minimal unsatisfiable subset: " << core.size() << " clauses, "
+                 << extractor.calls << " solver calls" << endl;
+        } else {
+            cout << "c Stopped: " << budget->reason() << ", core of " << core.size() << " clauses is not minimal" << endl;
+        }
+    }
+
+    cout << "s UNSATISFIABLE" << endl;
+    cout << "v ";
+    for (int i : core) cout << i + 1 << " ";
+    cout << "0" << endl;
+    return res;
+}
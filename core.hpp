@@ -0,0 +1,32 @@
+#ifndef CORE_H
+#define CORE_H
+
+#include "SAT-solver.hpp"
+#include "cdcl.hpp"
+
+/**
+ * Finds unsatisfiable subsets of a clause set by clause index. Every clause i is extended with
+ * the negation of its own selector variable, so assuming a set of selectors enables exactly
+ * those clauses, and the failed assumptions of an unsatisfiable call form a core.
+ * All calls go to the same incremental solver, so learnt clauses carry over between them.
+*/
+class CoreExtractor {
+    public:
+        CoreExtractor(Clause **clause_set, int n, SearchBudget *budget);
+        int find_core(vector<int> *core);
+        bool minimize(vector<int> *core);
+        void model(vector<literal> *model);
+        uint64_t calls = 0;
+    private:
+        CdclSolver solver;
+        int n;
+        uint32_t first_selector;
+
+        uint32_t selector(int i) { return mk_lit(first_selector + i, true); }
+        int solve_with(const vector<int> &clauses, vector<int> *core);
+        void disable(int i);
+};
+
+int extract_core(Clause **clause_set, int n, uint32_t num_vars, bool minimize, SearchBudget *budget);
+
+#endif
@@ -0,0 +1,295 @@
+#include <algorithm>
+#include <numeric>
+#include "count.hpp"
+
+// Bookkeeping per cache entry besides its count and the two copies of its key
+const uint64_t CACHE_ENTRY_OVERHEAD = 64;
+
+ModelCounter::ModelCounter(uint64_t max_cache_mb, SearchBudget *budget) {
+    max_cache_bytes = max_cache_mb << 20;
+    this->budget = budget;
+}
+
+/**
+ * Sets a variable of the sequent, dropping the unit clause the cut adds for it.
+ * The variable no longer occurs in the returned sequent.
+*/
+static Sequent *assign(Sequent *seq, uint32_t var, bool val) {
+    Sequent *child = atomic_cut_create_sequent(seq->clause_set, seq->n, var, val);
+    free_clause(child->clause_set[--child->n]);
+    return child;
+}
+
+/**
+ * Sets the literals of the unit clauses of a sequent and every literal they imply, following occurrence
+ * lists from each falsified literal, so a chain of units costs one pass rather than one copy per unit.
+ * Returns the sequent of the clauses left open, without their false literals, or NULL if a clause is
+ * falsified. assigned receives the number of variables set.
+*/
+static Sequent *propagate_units(Sequent *seq, uint64_t *assigned) {
+    unordered_map<uint32_t, uint32_t> index;
+    for (auto const& [var, count] : seq->var_count)
+        index.emplace(var, index.size());
+
+    // Literal codes of every clause, and the clauses each code occurs in
+    vector<vector<uint32_t>> codes(seq->n);
+    vector<vector<int>> occurs(2 * index.size());
+    for (int i = 0; i < seq->n; i++) {
+        Clause *cl = seq->clause_set[i];
+        for (int j = 0; j < cl->n; j++) {
+            uint32_t code = 2 * index[cl->literals[j].var] + (cl->literals[j].positive ? 0 : 1);
+            codes[i].push_back(code);
+            occurs[code].push_back(i);
+        }
+    }
+
+    // Value of each variable index: 1 true, -1 false, 0 open; trail holds the codes set true in order
+    vector<signed char> value(index.size(), 0);
+    vector<uint32_t> trail;
+    auto lit_value = [&](uint32_t code) { return (code & 1) ? -value[code >> 1] : value[code >> 1]; };
+    auto set_true = [&](uint32_t code) {
+        if (lit_value(code) != 0) return lit_value(code) == 1;
+        value[code >> 1] = (code & 1) ? -1 : 1;
+        trail.push_back(code);
+        return true;
+    };
+
+    bool conflict = false;
+    for (int i = 0; i < seq->n && !conflict; i++)
+        if (codes[i].size() == 1) conflict = !set_true(codes[i][0]);
+
+    for (size_t head = 0; head < trail.size() && !conflict; head++) {
+        for (int i : occurs[trail[head] ^ 1]) {
+            // The clause is satisfied, has one open literal left (possibly repeated), or more
+            bool satisfied = false;
+            int open = 0;
+            uint32_t unit = 0;
+            for (uint32_t code : codes[i]) {
+                int v = lit_value(code);
+                if (v == 1) satisfied = true;
+                if (v != 0 || (open == 1 && code == unit)) continue;
+                unit = code;
+                open++;
+            }
+            if (satisfied || open > 1) continue;
+            if (open == 0) {
+                conflict = true;
+                break;
+            }
+            set_true(unit);
+        }
+    }
+
+    *assigned = trail.size();
+    if (conflict) return NULL;
+
+    vector<Clause*> remaining;
+    for (int i = 0; i < seq->n; i++) {
+        bool satisfied = false;
+        for (uint32_t code : codes[i]) satisfied = satisfied || lit_value(code) == 1;
+        if (satisfied) continue;
+
+        Clause *cl = seq->clause_set[i];
+        literal *literals = new literal[cl->n];
+        int k = 0;
+        for (int j = 0; j < cl->n; j++)
+            if (lit_value(codes[i][j]) == 0) literals[k++] = cl->literals[j];
+        remaining.push_back(new Clause(literals, k));
+    }
+
+    Clause **clause_set = new Clause*[remaining.size()];
+    copy(remaining.begin(), remaining.end(), clause_set);
+    return create_root_sequent(clause_set, remaining.size());
+}
+
+/**
+ * Canonical encoding of a clause set: sorted literal codes of each sorted clause, 0-separated.
+*/
+static string component_key(Sequent *seq) {
+    vector<vector<uint32_t>> clauses(seq->n);
+    for (int i = 0; i < seq->n; i++) {
+        Clause *cl = seq->clause_set[i];
+        for (int j = 0; j < cl->n; j++)
+            clauses[i].push_back(2 * cl->literals[j].var + (cl->literals[j].positive ? 0 : 1));
+        sort(clauses[i].begin(), clauses[i].end());
+    }
+    sort(clauses.begin(), clauses.end());
+
+    vector<uint32_t> codes;
+    for (const vector<uint32_t> &cl : clauses) {
+        codes.insert(codes.end(), cl.begin(), cl.end());
+        codes.push_back(0);
+    }
+    return string((const char *)codes.data(), codes.size() * sizeof(uint32_t));
+}
+
+static uint32_t find_root(vector<uint32_t> &parent, uint32_t x) {
+    while (parent[x] != x) {
+        parent[x] = parent[parent[x]];
+        x = parent[x];
+    }
+    return x;
+}
+
+/**
+ * Splits a sequent into sequents over disjoint sets of variables.
+ * Returns an empty list if the sequent forms a single component.
+*/
+static vector<Sequent*> split_components(Sequent *seq) {
+    unordered_map<uint32_t, uint32_t> index;
+    for (auto const& [var, count] : seq->var_count)
+        index.emplace(var, index.size());
+
+    vector<uint32_t> parent(index.size());
+    iota(parent.begin(), parent.end(), 0);
+    for (int i = 0; i < seq->n; i++) {
+        Clause *cl = seq->clause_set[i];
+        for (int j = 1; j < cl->n; j++) {
+            uint32_t a = find_root(parent, index[cl->literals[0].var]);
+            uint32_t b = find_root(parent, index[cl->literals[j].var]);
+            if (a != b) parent[a] = b;
+        }
+    }
+
+    // Groups the clauses by the root of their first variable
+    unordered_map<uint32_t, vector<int>> groups;
+    for (int i = 0; i < seq->n; i++)
+        groups[find_root(parent, index[seq->clause_set[i]->literals[0].var])].push_back(i);
+
+    vector<Sequent*> components;
+    if (groups.size() < 2) return components;
+
+    for (auto const& [root, members] : groups) {
+        Clause **clause_set = new Clause*[members.size()];
+        for (size_t k = 0; k < members.size(); k++)
+            clause_set[k] = deep_cp_clause(seq->clause_set[members[k]], 0);
+        components.push_back(create_root_sequent(clause_set, members.size()));
+    }
+    return components;
+}
+
+void ModelCounter::cache_store(const string &key, const BigInt &value) {
+    uint64_t size = 2 * key.size() + value.bytes() + CACHE_ENTRY_OVERHEAD;
+    if (size > max_cache_bytes) return;
+
+    while (cache_bytes + size > max_cache_bytes) {
+        auto it = cache.find(cache_order.front());
+        cache_bytes -= 2 * it->first.size() + it->second.bytes() + CACHE_ENTRY_OVERHEAD;
+        cache.erase(it);
+        cache_order.pop_front();
+        stats.evictions++;
+    }
+
+    if (cache.emplace(key, value).second) {
+        cache_order.push_back(key);
+        cache_bytes += size;
+    }
+}
+
+/**
+ * Counts the models of a sequent over the variables occurring in it, taking ownership of the sequent.
+ * Returns 0 with aborted() set once the budget is exhausted.
+*/
+BigInt ModelCounter::count(Sequent *seq) {
+    if (stopped || budget->exhausted(stats.decisions, stats.propagations)) {
+        stopped = true;
+        free_sequent(seq);
+        return 0;
+    }
+
+    if (seq->n == 0) {
+        free_sequent(seq);
+        return 1;
+    }
+
+    bool has_unit = false;
+    for (int i = 0; i < seq->n; i++) {
+        if (seq->clause_set[i]->n == 0) {
+            // Empty clause
+            free_sequent(seq);
+            return 0;
+        }
+        if (seq->clause_set[i]->n == 1) has_unit = true;
+    }
+
+    if (has_unit) {
+        // Only the branch satisfying the unit clauses, and the literals they imply, has models
+        uint64_t assigned;
+        Sequent *child = propagate_units(seq, &assigned);
+        stats.propagations += assigned;
+        if (child == NULL) {
+            free_sequent(seq);
+            return 0;
+        }
+        uint64_t free_vars = seq->var_count.size() - assigned - child->var_count.size();
+        free_sequent(seq);
+        return count(child).shift_left(free_vars);
+    }
+
+    vector<Sequent*> components = split_components(seq);
+    if (components.empty()) return count_component(seq);
+
+    free_sequent(seq);
+    stats.components += components.size();
+    BigInt product = 1;
+    for (Sequent *component : components) {
+        // Skips the remaining components once the product is known to be 0
+        if (product.is_zero()) free_sequent(component);
+        else product = product * count(component);
+    }
+    return product;
+}
+
+/**
+ * Counts a connected sequent without unit clauses by cutting on its most frequent variable.
+*/
+BigInt ModelCounter::count_component(Sequent *seq) {
+    string key = component_key(seq);
+    auto it = cache.find(key);
+    if (it != cache.end()) {
+        stats.cache_hits++;
+        free_sequent(seq);
+        return it->second;
+    }
+    stats.cache_misses++;
+
+    // Every variable occurring once means a single clause, cut on any of its variables
+    uint32_t var = choose_cut_var(seq);
+    if (var == 0) var = seq->var_count.begin()->first;
+
+    BigInt total;
+    stats.decisions++;
+    for (int branch = 0; branch < 2 && !stopped; branch++) {
+        Sequent *child = assign(seq, var, branch == 0);
+        uint64_t free_vars = seq->var_count.size() - 1 - child->var_count.size();
+        total += count(child).shift_left(free_vars);
+    }
+    free_sequent(seq);
+
+    if (!stopped) cache_store(key, total);
+    return total;
+}
+
+/**
+ * Counts the models of a clause set over variables 1 .. num_vars, taking ownership of the clause set.
+ * Returns false if the budget ran out before the count was complete.
+*/
+bool count_models(Clause **clause_set, int n, uint32_t num_vars, uint64_t max_cache_mb, SearchBudget *budget, BigInt *count) {
+    Sequent *root = create_root_sequent(clause_set, n);
+    uint64_t occurring = root->var_count.size();
+    uint32_t max_var = root->var_count.empty() ? 0 : root->var_count.rbegin()->first;
+    num_vars = max(num_vars, max_var);
+
+    ModelCounter counter(max_cache_mb, budget);
+    *count = counter.count(root);
+    count->shift_left(num_vars - occurring);
+
+    count_stats &s = counter.stats;
+    budget->add_work(s.decisions, s.propagations);
+    cout << "c Counting: decisions " << s.decisions << ", propagations " << s.propagations
+         << ", components " << s.components << endl;
+    cout << "c   cache hits " << s.cache_hits << ", misses " << s.cache_misses
+         << ", evictions " << s.evictions << endl;
+
+    return !counter.aborted();
+}
@@ -0,0 +1,44 @@
+#ifndef COUNT_H
+#define COUNT_H
+
+#include <deque>
+#include <unordered_map>
+#include "SAT-solver.hpp"
+#include "bigint.hpp"
+
+struct count_stats {
+    uint64_t decisions = 0;
+    uint64_t propagations = 0;
+    uint64_t components = 0;
+    uint64_t cache_hits = 0;
+    uint64_t cache_misses = 0;
+    uint64_t evictions = 0;
+};
+
+/**
+ * Exact model counter over the atomic-cut tree. Unit clauses and the literals they imply are set in one pass,
+ * residual sequents are split into variable-disjoint components whose counts multiply,
+ * and component counts are cached under a canonical encoding of their clauses.
+ * The cache is bounded in bytes and evicts its oldest entries first.
+*/
+class ModelCounter {
+    public:
+        ModelCounter(uint64_t max_cache_mb, SearchBudget *budget);
+        BigInt count(Sequent *seq);
+        bool aborted() { return stopped; }
+        count_stats stats;
+    private:
+        unordered_map<string, BigInt> cache;
+        deque<string> cache_order;
+        uint64_t cache_bytes = 0;
+        uint64_t max_cache_bytes;
+        SearchBudget *budget;
+        bool stopped = false;
+
+        BigInt count_component(Sequent *seq);
+        void cache_store(const string &key, const BigInt &value);
+};
+
+bool count_models(Clause **clause_set, int n, uint32_t num_vars, uint64_t max_cache_mb, SearchBudget *budget, BigInt *count);
+
+#endif
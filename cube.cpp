@@ -0,0 +1,261 @@
+#include <algorithm>
+#include <deque>
+#include "cube.hpp"
+
+struct Conquer {
+    Sequent *root;
+    const vector<vector<literal>> *cubes;
+    atomic<size_t> next{0};
+    atomic<bool> stop{false};
+    atomic<long> refuted{0};
+    SearchBudget *budget;
+    mutex model_lock;
+    bool found = false;
+    vector<literal> model;
+};
+
+static long literal_total(Sequent *seq) {
+    long total = 0;
+    for (int i = 0; i < seq->n; i++)
+        total += seq->clause_set[i]->n;
+    return total;
+}
+
+/**
+ * Creates the sequent of a cube by applying its atomic cuts to the root one after the other,
+ * simplifying after each cut. The root is only read, and the result is always a new sequent.
+*/
+Sequent *build_cube_sequent(Sequent *root, const vector<literal> &cube) {
+    if (cube.empty()) {
+        Clause **clause_set = new Clause*[root->n];
+        for (int i = 0; i < root->n; i++)
+            clause_set[i] = deep_cp_clause(root->clause_set[i], 0);
+        return create_root_sequent(clause_set, root->n);
+    }
+
+    Sequent *seq = root;
+    for (literal lit : cube) {
+        Sequent *child = atomic_cut_create_sequent(seq->clause_set, seq->n, lit.var, lit.positive);
+        while (child->propagate());
+        if (seq != root) free_sequent(seq);
+        seq = child;
+    }
+    return seq;
+}
+
+/**
+ * Chooses a split variable by look-ahead: the most frequent variables are cut on tentatively,
+ * and the one whose two simplified sequents shrink the most (product of the removed literals)
+ * is chosen. A variable with a closed branch is chosen immediately, as that branch needs no cube.
+ * Returns 0 if no variable occurs more than once, or if the budget ran out first.
+*/
+uint32_t lookahead_cut_var(Sequent *seq, int num_candidates, SearchBudget *budget, bool *left_closed, bool *right_closed) {
+    vector<pair<int, uint32_t>> candidates;
+    for (auto const& [key, count] : seq->var_count)
+        if (count > 1) candidates.push_back({count, key});
+
+    *left_closed = false;
+    *right_closed = false;
+    if (candidates.empty()) return 0;
+
+    int k = min((int)candidates.size(), num_candidates);
+    partial_sort(candidates.begin(), candidates.begin() + k, candidates.end(), greater<pair<int, uint32_t>>());
+
+    long base = literal_total(seq);
+    long best_score = -1;
+    uint32_t best_var = 0;
+
+    for (int c = 0; c < k; c++) {
+        if (budget->exhausted_now()) return 0;
+        uint32_t var = candidates[c].second;
+        Sequent *left;
+        Sequent *right;
+        apply_atomic_cut(seq, &left, &right, var);
+        while (left->propagate());
+        while (right->propagate());
+
+        bool lc = left->is_axiom();
+        bool rc = right->is_axiom();
+        long dl = base - literal_total(left);
+        long dr = base - literal_total(right);
+        free_sequent(left);
+        free_sequent(right);
+
+        if (lc || rc) {
+            *left_closed = lc;
+            *right_closed = rc;
+            return var;
+        }
+
+        long score = dl * dr + dl + dr;
+        if (score > best_score) {
+            best_score = score;
+            best_var = var;
+        }
+    }
+
+    return best_var;
+}
+
+/**
+ * Splits the propagated root sequent into cubes, breadth-first, so the cube tree stays balanced.
+ * A cube is split further while it is shorter than the maximum depth and the cube count allows it.
+ * Branches closed during look-ahead are dropped. Returns true, with the model, if a
+ * sequent reached while splitting turned out to be satisfiable. Stops early, returning false,
+ * once the budget runs out.
+*/
+bool split_into_cubes(Sequent *root, const cube_options &opts, SearchBudget *budget, vector<vector<literal>> *cubes, vector<literal> *model) {
+    deque<vector<literal>> open;
+    open.push_back(vector<literal>());
+
+    while (!open.empty()) {
+        vector<literal> cube = open.front();
+        open.pop_front();
+
+        if ((int)cube.size() >= opts.max_depth || (int)(cubes->size() + open.size()) + 2 > opts.max_cubes) {
+            cubes->push_back(cube);
+            continue;
+        }
+
+        Sequent *seq = cube.empty() ? root : build_cube_sequent(root, cube);
+        bool closed = seq->is_axiom();
+        bool left_closed = false;
+        bool right_closed = false;
+        uint32_t var = closed ? 0 : lookahead_cut_var(seq, opts.num_candidates, budget, &left_closed, &right_closed);
+
+        if (budget->stopped()) {
+            if (seq != root) free_sequent(seq);
+            return false;
+        }
+        if (!closed && var == 0) {
+            // Atomic cut impossible, the sequent is satisfiable
+            sequent_model(seq, model);
+            if (seq != root) free_sequent(seq);
+            return true;
+        }
+        if (seq != root) free_sequent(seq);
+        if (closed) continue;
+
+        if (!left_closed) {
+            cube.push_back({var, true});
+            open.push_back(cube);
+            cube.pop_back();
+        }
+        if (!right_closed) {
+            cube.push_back({var, false});
+            open.push_back(cube);
+        }
+    }
+
+    return false;
+}
+
+/**
+ * Writes the clause set of the root sequent and the cubes as assumptions in iCNF format.
+*/
+bool write_icnf(Sequent *root, const vector<vector<literal>> &cubes, string filename) {
+    ofstream output(filename);
+    if (!output) {
+        cerr << "Error: cannot open " << filename << endl;
+        return false;
+    }
+
+    output << "p inccnf" << "\n";
+    for (int i = 0; i < root->n; i++) {
+        Clause *cl = root->clause_set[i];
+        for (int j = 0; j < cl->n; j++)
+            output << (cl->literals[j].positive ? "" : "-") << cl->literals[j].var << " ";
+        output << "0\n";
+    }
+    for (const vector<literal> &cube : cubes) {
+        output << "a ";
+        for (literal lit : cube)
+            output << (lit.positive ? "" : "-") << lit.var << " ";
+        output << "0\n";
+    }
+
+    return true;
+}
+
+static void conquer_worker(Conquer *c) {
+    search_context ctx;
+    ctx.stop = &c->stop;
+    ctx.budget = c->budget;
+
+    while (!c->stop.load() && !c->budget->stopped()) {
+        size_t i = c->next.fetch_add(1);
+        if (i >= c->cubes->size()) break;
+
+        bool res;
+        try {
+            Sequent *seq = build_cube_sequent(c->root, (*c->cubes)[i]);
+            res = prove(seq, &ctx);
+        } catch (const bad_alloc &) {
+            // Leaks the sequents of the cube and stops the other workers through the budget
+            c->budget->trip("out of memory");
+            break;
+        }
+        if (res == 1) {
+            lock_guard<mutex> guard(c->model_lock);
+            if (!c->found) {
+                c->found = true;
+                c->model = ctx.model;
+            }
+            c->stop.store(true);
+        } else if (!c->stop.load() && !c->budget->stopped()) {
+            c->refuted.fetch_add(1);
+        }
+    }
+
+    c->budget->add_work(ctx.decisions, ctx.propagations);
+}
+
+/**
+ * Cube-and-conquer: splits the sequent into cubes by look-ahead, optionally writes them in iCNF format,
+ * then solves the cubes with a pool of threads running prove(). The root is shared read-only
+ * while the cubes are solved, and the search stops as soon as one cube is satisfiable.
+*/
+bool prove_cubes(Sequent *root, const cube_options &opts, int num_threads, SearchBudget *budget, vector<literal> *model) {
+    while (root->propagate());
+
+    if (root->is_axiom()) {
+        free_sequent(root);
+        return 0;
+    }
+
+    vector<vector<literal>> cubes;
+    if (split_into_cubes(root, opts, budget, &cubes, model)) {
+        cout << "c Cube-and-conquer: model found while splitting" << endl;
+        free_sequent(root);
+        return 1;
+    }
+    if (budget->stopped()) {
+        free_sequent(root);
+        return 0;
+    }
+
+    size_t max_len = 0;
+    for (const vector<literal> &cube : cubes) max_len = max(max_len, cube.size());
+    cout << "c Cube-and-conquer: " << cubes.size() << " cubes, depth up to " << max_len << endl;
+
+    if (!opts.icnf_file.empty() && write_icnf(root, cubes, opts.icnf_file))
+        cout << "c Cubes written to " << opts.icnf_file << endl;
+
+    Conquer c;
+    c.root = root;
+    c.cubes = &cubes;
+    c.budget = budget;
+
+    vector<thread> threads;
+    for (int i = 0; i < num_threads; i++)
+        threads.push_back(thread(conquer_worker, &c));
+    for (thread &t : threads)
+        t.join();
+
+    cout << "c Cube-and-conquer: " << c.refuted.load() << " cubes refuted" << endl;
+
+    if (c.found) *model = c.model;
+    free_sequent(root);
+
+    return c.found;
+}
@@ -0,0 +1,23 @@
+#ifndef CUBE_H
+#define CUBE_H
+
+#include <thread>
+#include <mutex>
+#include "SAT-solver.hpp"
+
+struct cube_options {
+    int max_cubes = 1024;
+    int max_depth = 32;
+    // Number of split variable candidates evaluated by look-ahead
+    int num_candidates = 8;
+    string icnf_file;
+};
+
+Sequent *build_cube_sequent(Sequent *root, const vector<literal> &cube);
+uint32_t lookahead_cut_var(Sequent *seq, int num_candidates, SearchBudget *budget, bool *left_closed, bool *right_closed);
+bool split_into_cubes(Sequent *root, const cube_options &opts, SearchBudget *budget, vector<vector<literal>> *cubes, vector<literal> *model);
+bool write_icnf(Sequent *root, const vector<vector<literal>> &cubes, string filename);
+
+bool prove_cubes(Sequent *root, const cube_options &opts, int num_threads, SearchBudget *budget, vector<literal> *model);
+
+#endif
@@ -0,0 +1,51 @@
+#include <algorithm>
+#include "enumerate.hpp"
+
+/**
+ * Enumerates the models of a formula projected onto the given variables, by default all variables
+ * declared by the input (num_vars) or occurring in the formula, including those in no clause,
+ * writing each one as a 'v' line as soon as it is found. No two models agree on the projection.
+ * Stops after max_models models if it is not 0, or when the budget is exhausted.
+ * The full assignment behind every model is verified against the formula before the model is written;
+ * verified becomes false, ending the enumeration, if one is wrong.
+ * Returns the number of models written.
+*/
+uint64_t enumerate_models(const CnfFormula &formula, uint32_t num_vars, const vector<uint32_t> &projection,
+                          uint64_t max_models, SearchBudget *budget, bool *verified) {
+    vector<uint32_t> vars = projection;
+    sort(vars.begin(), vars.end());
+    vars.erase(unique(vars.begin(), vars.end()), vars.end());
+    if (vars.empty()) {
+        for (uint32_t v = 1; v <= max(num_vars, formula.num_vars); v++) vars.push_back(v);
+    }
+
+    CdclSolver solver(&formula);
+    solver.budget = budget;
+    solver.set_projection(vars);
+
+    uint64_t count = 0;
+    vector<literal> model;
+    vector<literal> assignment;
+    double verify_seconds = 0;
+    *verified = true;
+    while (max_models == 0 || count < max_models) {
+        if (solver.next_model() != CDCL_SAT) break;
+
+        assignment.clear();
+        for (uint32_t v = 1; v <= formula.num_vars; v++) assignment.push_back({v, solver.model_value(v)});
+        chrono::steady_clock::time_point start = chrono::steady_clock::now();
+        *verified = verify_model(formula, formula.num_vars, &assignment);
+        verify_seconds += chrono::duration<double>(chrono::steady_clock::now() - start).count();
+        if (!*verified) break;
+
+        model.clear();
+        for (uint32_t v : vars) model.push_back({v, solver.model_value(v)});
+        print_model(model);
+        count++;
+    }
+
+    budget->add_work(solver.stats.decisions, solver.stats.propagations);
+    if (count > 0) cout << "c Models verified against " << formula.num_clauses() << " clauses in " << verify_seconds << " s" << endl;
+    cout << "c Enumeration: " << count << " models, " << solver.stats.conflicts << " conflicts" << endl;
+    return count;
+}
@@ -0,0 +1,10 @@
+#ifndef ENUMERATE_H
+#define ENUMERATE_H
+
+#include "SAT-solver.hpp"
+#include "cdcl.hpp"
+
+uint64_t enumerate_models(const CnfFormula &formula, uint32_t num_vars, const vector<uint32_t> &projection,
+                          uint64_t max_models, SearchBudget *budget, bool *verified);
+
+#endif
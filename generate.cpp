@@ -0,0 +1,225 @@
+#include <algorithm>
+#include <set>
+#include "generate.hpp"
+#include "cnf_io.hpp"
+
+/**
+ * Collects clauses of DIMACS literals straight into the solver's clause storage.
+*/
+class InstanceBuilder {
+    public:
+        uint32_t num_vars = 0;
+
+        void add(const vector<int> &lits) {
+            literal *literals = new literal[lits.size()];
+            for (size_t i = 0; i < lits.size(); i++) {
+                literals[i] = {(uint32_t)abs(lits[i]), lits[i] > 0};
+                num_vars = max(num_vars, literals[i].var);
+            }
+            clauses.push_back(new Clause(literals, lits.size()));
+        }
+
+        Clause **release(int *n) {
+            Clause **clause_set = new Clause*[clauses.size()];
+            copy(clauses.begin(), clauses.end(), clause_set);
+            *n = clauses.size();
+            clauses.clear();
+            return clause_set;
+        }
+    private:
+        vector<Clause*> clauses;
+};
+
+static uint32_t next_random(uint32_t *rng) {
+    *rng ^= *rng << 13;
+    *rng ^= *rng >> 17;
+    *rng ^= *rng << 5;
+    return *rng;
+}
+
+static uint32_t seed_rng(uint32_t seed) {
+    uint32_t rng = seed * 2654435761u + 2463534242u;
+    return rng == 0 ? 1 : rng;
+}
+
+/**
+ * Picks k distinct variables of 1 .. num_vars with random signs. If planted is given,
+ * one literal is flipped when needed so that the clause is satisfied by it.
+*/
+static vector<int> random_clause(int num_vars, int k, uint32_t *rng, const vector<bool> *planted) {
+    vector<int> lits;
+    while ((int)lits.size() < k) {
+        int var = next_random(rng) % num_vars + 1;
+        bool fresh = true;
+        for (int lit : lits) fresh = fresh && abs(lit) != var;
+        if (fresh) lits.push_back(next_random(rng) & 1 ? var : -var);
+    }
+
+    if (planted != NULL) {
+        bool satisfied = false;
+        for (int lit : lits) satisfied = satisfied || (*planted)[abs(lit)] == (lit > 0);
+        if (!satisfied) {
+            int i = next_random(rng) % k;
+            lits[i] = -lits[i];
+        }
+    }
+    return lits;
+}
+
+/**
+ * Uniform random k-SAT, or k-SAT satisfied by a hidden random assignment.
+*/
+static void random_ksat(InstanceBuilder *b, const generator_options &opts, bool plant) {
+    uint32_t rng = seed_rng(opts.seed);
+    double ratio = opts.ratio > 0 ? opts.ratio : 4.26;
+    long m = lround(ratio * opts.size);
+
+    vector<bool> planted(opts.size + 1);
+    for (int v = 1; v <= opts.size; v++) planted[v] = next_random(&rng) & 1;
+
+    b->num_vars = opts.size;
+    for (long i = 0; i < m; i++)
+        b->add(random_clause(opts.size, opts.k, &rng, plant ? &planted : NULL));
+}
+
+/**
+ * Pigeonhole principle: size + 1 pigeons in size holes, unsatisfiable.
+ * Variable i * size + j + 1 places pigeon i in hole j.
+*/
+static void pigeonhole(InstanceBuilder *b, int holes) {
+    int pigeons = holes + 1;
+    for (int i = 0; i < pigeons; i++) {
+        vector<int> somewhere;
+        for (int j = 0; j < holes; j++) somewhere.push_back(i * holes + j + 1);
+        b->add(somewhere);
+    }
+    for (int j = 0; j < holes; j++)
+        for (int i1 = 0; i1 < pigeons; i1++)
+            for (int i2 = i1 + 1; i2 < pigeons; i2++)
+                b->add({-(i1 * holes + j + 1), -(i2 * holes + j + 1)});
+}
+
+/**
+ * Coloring of a random graph with ratio * size distinct edges, 2.3 by default, close to
+ * the 3-colorability threshold. Variable v * colors + c + 1 gives vertex v color c.
+*/
+static void graph_coloring(InstanceBuilder *b, const generator_options &opts) {
+    uint32_t rng = seed_rng(opts.seed);
+    int n = opts.size;
+    int colors = opts.colors;
+    double ratio = opts.ratio > 0 ? opts.ratio : 2.3;
+    long m = min((long)lround(ratio * n), (long)n * (n - 1) / 2);
+
+    for (int v = 0; v < n; v++) {
+        vector<int> some_color;
+        for (int c = 0; c < colors; c++) some_color.push_back(v * colors + c + 1);
+        b->add(some_color);
+        for (int c1 = 0; c1 < colors; c1++)
+            for (int c2 = c1 + 1; c2 < colors; c2++)
+                b->add({-(v * colors + c1 + 1), -(v * colors + c2 + 1)});
+    }
+
+    set<pair<int, int>> edges;
+    while ((long)edges.size() < m) {
+        int u = next_random(&rng) % n;
+        int v = next_random(&rng) % n;
+        if (u == v || !edges.insert({min(u, v), max(u, v)}).second) continue;
+        for (int c = 0; c < colors; c++)
+            b->add({-(u * colors + c + 1), -(v * colors + c + 1)});
+    }
+    b->num_vars = n * colors;
+}
+
+/**
+ * Adds c = a xor b as four ternary clauses.
+*/
+static void add_xor(InstanceBuilder *b, int a, int x, int c) {
+    b->add({-a, -x, -c});
+    b->add({a, x, -c});
+    b->add({a, -x, c});
+    b->add({-a, x, c});
+}
+
+/**
+ * Two xor chains over the variables 1 .. size, one in order and one in a random order,
+ * claiming opposite parities; unsatisfiable, and hard for resolution.
+ * Each chain has size - 1 auxiliary variables for its partial sums.
+*/
+static void parity_chains(InstanceBuilder *b, const generator_options &opts) {
+    uint32_t rng = seed_rng(opts.seed);
+    int n = opts.size;
+    vector<int> order(n);
+    for (int i = 0; i < n; i++) order[i] = i + 1;
+
+    int next_var = n + 1;
+    for (int chain = 0; chain < 2; chain++) {
+        if (chain == 1) {
+            for (int i = n - 1; i > 0; i--) swap(order[i], order[next_random(&rng) % (i + 1)]);
+        }
+        int sum = order[0];
+        for (int i = 1; i < n; i++) {
+            add_xor(b, sum, order[i], next_var);
+            sum = next_var++;
+        }
+        b->add({chain == 0 ? sum : -sum});
+    }
+    b->num_vars = next_var - 1;
+}
+
+/**
+ * Generates an instance of a family in time linear in its size.
+ * Returns NULL, printing the reason, for an unknown family or invalid parameters.
+*/
+Clause **generate_instance(const generator_options &opts, int *n, uint32_t *num_vars) {
+    InstanceBuilder b;
+    const string &f = opts.family;
+    if (opts.size < 1 || ((f == "ksat" || f == "planted") && (opts.k < 1 || opts.k > opts.size)) ||
+        (f == "coloring" && opts.colors < 1) || (f == "full" && opts.size > 24)) {
+        cerr << "Error: invalid parameters for the " << f << " generator" << endl;
+        return NULL;
+    }
+
+    if (f == "ksat" || f == "planted") {
+        random_ksat(&b, opts, f == "planted");
+    } else if (f == "php") {
+        pigeonhole(&b, opts.size);
+    } else if (f == "coloring") {
+        graph_coloring(&b, opts);
+    } else if (f == "parity") {
+        parity_chains(&b, opts);
+    } else if (f == "full") {
+        *n = 1 << opts.size;
+        *num_vars = opts.size;
+        return build_full_clause_set(opts.size);
+    } else {
+        cerr << "Error: unknown generator " << f << ", expected ksat, planted, php, coloring, parity or full" << endl;
+        return NULL;
+    }
+
+    *num_vars = b.num_vars;
+    return b.release(n);
+}
+
+/**
+ * Writes a clause set in DIMACS format with cnf_write. Returns false if the file cannot be written.
+*/
+bool write_cnf_file(Clause **clause_set, int n, uint32_t num_vars, string filename) {
+    int l_num = 0;
+    for (int i = 0; i < n; i++) l_num += clause_set[i]->n;
+
+    int *l_c_num = new int[n];
+    int *l_val = new int[l_num];
+    int k = 0;
+    for (int i = 0; i < n; i++) {
+        l_c_num[i] = clause_set[i]->n;
+        for (int j = 0; j < clause_set[i]->n; j++) {
+            literal lit = clause_set[i]->literals[j];
+            l_val[k++] = lit.positive ? (int)lit.var : -(int)lit.var;
+        }
+    }
+
+    bool error = cnf_write(num_vars, n, l_num, l_c_num, l_val, filename);
+    delete []l_c_num;
+    delete []l_val;
+    return !error;
+}
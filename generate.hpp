@@ -0,0 +1,23 @@
+#ifndef GENERATE_H
+#define GENERATE_H
+
+#include "SAT-solver.hpp"
+
+/**
+ * Instance families and their parameters. size is the number of variables (ksat, planted, full),
+ * holes (php), vertices (coloring) or chained variables (parity). ratio is clauses per variable,
+ * or edges per vertex for coloring; 0 selects the family default.
+*/
+struct generator_options {
+    string family;
+    int size = 0;
+    int k = 3;
+    double ratio = 0;
+    int colors = 3;
+    uint32_t seed = 0;
+};
+
+Clause **generate_instance(const generator_options &opts, int *n, uint32_t *num_vars);
+bool write_cnf_file(Clause **clause_set, int n, uint32_t num_vars, string filename);
+
+#endif
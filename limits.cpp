@@ -0,0 +1,106 @@
+#include <fstream>
+#include <unistd.h>
+#include "limits.hpp"
+#include "memory.hpp"
+
+static thread_local uint32_t budget_ticks = 0;
+
+// Counters of the calling thread already added to the totals of a budget
+struct published_work {
+    uint64_t budget = 0;
+    uint64_t decisions = 0;
+    uint64_t propagations = 0;
+};
+
+static thread_local published_work published;
+static atomic<uint64_t> next_budget_id{1};
+
+SearchBudget::SearchBudget(const solve_limits &limits) {
+    this->limits = limits;
+    id = next_budget_id.fetch_add(1);
+    start = chrono::steady_clock::now();
+}
+
+/**
+ * Stops the budget for good, keeping the first reason given. Search threads that cannot go on,
+ * e.g. out of memory, trip it themselves so that the others wind down.
+*/
+bool SearchBudget::trip(const char *why) {
+    bool expected = false;
+    if (stop.compare_exchange_strong(expected, true)) stop_reason = why;
+    return true;
+}
+
+/**
+ * Adds the work of the calling thread since its last call to the shared totals.
+ * Counters that went down belong to a new search, which starts from 0.
+*/
+void SearchBudget::publish(uint64_t decisions, uint64_t propagations) {
+    if (published.budget != id || decisions < published.decisions || propagations < published.propagations)
+        published = {id, 0, 0};
+    decisions_done.fetch_add(decisions - published.decisions, memory_order_relaxed);
+    propagations_done.fetch_add(propagations - published.propagations, memory_order_relaxed);
+    published.decisions = decisions;
+    published.propagations = propagations;
+}
+
+bool SearchBudget::exhausted(uint64_t decisions, uint64_t propagations) {
+    if (stop.load(memory_order_relaxed)) return true;
+    if (limits.terminate != NULL && limits.terminate->load(memory_order_relaxed)) return trip("interrupted");
+
+    uint64_t pending_decisions = decisions;
+    uint64_t pending_propagations = propagations;
+    if (published.budget == id && decisions >= published.decisions && propagations >= published.propagations) {
+        pending_decisions -= published.decisions;
+        pending_propagations -= published.propagations;
+    }
+    if (limits.max_decisions != 0 &&
+        decisions_done.load(memory_order_relaxed) + pending_decisions >= limits.max_decisions) return trip("decision limit");
+    if (limits.max_propagations != 0 &&
+        propagations_done.load(memory_order_relaxed) + pending_propagations >= limits.max_propagations) return trip("propagation limit");
+
+    if (++budget_ticks & 63) return false;
+
+    publish(decisions, propagations);
+    if (limits.time_limit > 0 && elapsed() >= limits.time_limit) return trip("time limit");
+    if (limits.max_memory_mb != 0 && tracked_memory_bytes() >= limits.max_memory_mb << 20) return trip("memory limit");
+
+    if (budget_ticks & 1023) return false;
+    if (limits.max_memory_mb != 0 && resident_memory_bytes() >= limits.max_memory_mb << 20) return trip("memory limit");
+    return false;
+}
+
+/**
+ * Checks cancellation, the clock and the accounted memory on every call, for steps too expensive
+ * to check only every 64th. Counters are not involved.
+*/
+bool SearchBudget::exhausted_now() {
+    if (stop.load(memory_order_relaxed)) return true;
+    if (limits.terminate != NULL && limits.terminate->load(memory_order_relaxed)) return trip("interrupted");
+    if (limits.time_limit > 0 && elapsed() >= limits.time_limit) return trip("time limit");
+    if (limits.max_memory_mb != 0 && tracked_memory_bytes() >= limits.max_memory_mb << 20) return trip("memory limit");
+    return false;
+}
+
+/**
+ * Publishes the rest of the work of a finished search thread, for the limits and the final statistics.
+*/
+void SearchBudget::add_work(uint64_t decisions, uint64_t propagations) {
+    publish(decisions, propagations);
+    published = published_work();
+}
+
+double SearchBudget::elapsed() {
+    return chrono::duration<double>(chrono::steady_clock::now() - start).count();
+}
+
+/**
+ * Resident set size of the process, read from /proc/self/statm. Returns 0 where unavailable.
+*/
+uint64_t resident_memory_bytes() {
+    ifstream statm("/proc/self/statm");
+    uint64_t size = 0;
+    uint64_t resident = 0;
+    if (!(statm >> size >> resident)) return 0;
+    return resident * (uint64_t)sysconf(_SC_PAGESIZE);
+}
@@ -0,0 +1,53 @@
+#ifndef LIMITS_H
+#define LIMITS_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+using namespace std;
+
+struct solve_limits {
+    // Wall time in seconds, 0 for none
+    double time_limit = 0;
+    uint64_t max_decisions = 0;
+    uint64_t max_propagations = 0;
+    uint64_t max_memory_mb = 0;
+    // Set by any thread to cancel the search
+    atomic<bool> *terminate = NULL;
+};
+
+/**
+ * Resource budget of one solve() call, shared by all of its search threads.
+ * Searches call exhausted() with their own counters at every decision. The counters of all
+ * threads are added to shared totals in batches, every 64th call of a thread, and the limits
+ * apply to those totals plus the thread's unpublished work, so they bound the whole job.
+ * The clock and the accounted memory are read every 64th call of a thread, resident memory every 1024th.
+ * Once a limit is hit the budget stays exhausted, so every thread winds down.
+*/
+class SearchBudget {
+    public:
+        SearchBudget(const solve_limits &limits);
+        bool exhausted(uint64_t decisions, uint64_t propagations);
+        bool exhausted_now();
+        bool stopped() { return stop.load(memory_order_relaxed); }
+        const char *reason() { return stop_reason; }
+        void add_work(uint64_t decisions, uint64_t propagations);
+        uint64_t total_decisions() { return decisions_done.load(); }
+        uint64_t total_propagations() { return propagations_done.load(); }
+        double elapsed();
+        bool trip(const char *why);
+    private:
+        solve_limits limits;
+        // Distinguishes budgets in the per-thread record of published work
+        uint64_t id;
+        chrono::steady_clock::time_point start;
+        atomic<bool> stop{false};
+        const char *stop_reason = "";
+        atomic<uint64_t> decisions_done{0};
+        atomic<uint64_t> propagations_done{0};
+        void publish(uint64_t decisions, uint64_t propagations);
+};
+
+uint64_t resident_memory_bytes();
+
+#endif
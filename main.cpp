@@ -0,0 +1,525 @@
+#include <csignal>
+#include <climits>
+#include <cstring>
+#include "SAT-solver.hpp"
+#include "server.hpp"
+#include "generate.hpp"
+#include "benchmark.hpp"
+#include "batch.hpp"
+#include "stats.hpp"
+#include "trace.hpp"
+
+static atomic<bool> interrupted{false};
+
+static void handle_interrupt(int) {
+    interrupted.store(true);
+}
+
+static void handle_stats_request(int) {
+    request_stats_dump();
+}
+
+/**
+ * Parses a comma-separated list of variables and ranges, such as 1,4-8,12.
+*/
+static bool parse_var_list(string list, vector<uint32_t> *vars) {
+    stringstream ss(list);
+    string item;
+    while (getline(ss, item, ',')) {
+        size_t dash = item.find('-');
+        try {
+            long first = stol(item.substr(0, dash));
+            long last = dash == string::npos ? first : stol(item.substr(dash + 1));
+            if (first < 1 || last < first) return false;
+            for (long v = first; v <= last; v++) vars->push_back(v);
+        } catch (const exception &e) {
+            return false;
+        }
+    }
+    return !vars->empty();
+}
+
+/**
+ * Parses a whole argument as an integer between min and max. Trailing characters and
+ * out-of-range values are rejected instead of thrown.
+*/
+static bool parse_int(const char *arg, long long min, long long max, long long *value) {
+    try {
+        size_t end;
+        *value = stoll(arg, &end);
+        return end == strlen(arg) && *value >= min && *value <= max;
+    } catch (const exception &e) {
+        return false;
+    }
+}
+
+/**
+ * Parses a whole argument as a positive number.
+*/
+static bool parse_positive(const char *arg, double *value) {
+    try {
+        size_t end;
+        *value = stod(arg, &end);
+        return end == strlen(arg) && *value > 0;
+    } catch (const exception &e) {
+        return false;
+    }
+}
+
+int main(int argc, char** argv) {
+    // Parse command line arguments
+    int test_val = 0;
+    string file_name;
+    string socket_path;
+    generator_options gen;
+    string gen_file;
+    string trace_file;
+    bench_options bench;
+    batch_options batch;
+    bool batch_mode = false;
+    solve_options opts;
+    long long value;
+    double seconds;
+
+    for (int i = 1; i < argc; ++i) {
+        string arg(argv[i]);
+        if (arg == "-test") {
+            // Test flag
+            if (++i >= argc || !parse_int(argv[i], 0, 24, &value)) {
+                cerr << "Error: please provide the value of the test flag (int, at most 24)" << endl;
+                return 1;
+            }
+            test_val = value;
+        } else if (arg == "-threads") {
+            // Number of worker threads for the parallel search
+            if (++i >= argc || !parse_int(argv[i], 1, INT_MAX, &value)) {
+                cerr << "Error: please provide a positive number of threads" << endl;
+                return 1;
+            }
+            opts.num_threads = value;
+        } else if (arg == "-portfolio") {
+            // Number of diversified solver instances racing on the same clause set
+            if (++i >= argc || !parse_int(argv[i], 1, INT_MAX, &value)) {
+                cerr << "Error: please provide a positive portfolio size" << endl;
+                return 1;
+            }
+            opts.portfolio_size = value;
+        } else if (arg == "-cdcl") {
+            // Number of cooperating clause-learning threads
+            if (++i >= argc || !parse_int(argv[i], 1, INT_MAX, &value)) {
+                cerr << "Error: please provide a positive number of CDCL threads" << endl;
+                return 1;
+            }
+            opts.cdcl_threads = value;
+        } else if (arg == "-cubes") {
+            // Cube-and-conquer with at most this many cubes
+            if (++i >= argc || !parse_int(argv[i], 1, INT_MAX, &value)) {
+                cerr << "Error: please provide a positive number of cubes" << endl;
+                return 1;
+            }
+            opts.cube_count = value;
+        } else if (arg == "-cube-depth") {
+            if (++i >= argc || !parse_int(argv[i], 0, INT_MAX, &value)) {
+                cerr << "Error: please provide a non-negative cube depth" << endl;
+                return 1;
+            }
+            opts.cube_depth = value;
+        } else if (arg == "-icnf") {
+            // Writes the cubes to a file in iCNF format
+            if (++i >= argc) {
+                cerr << "Error: please provide the name of the iCNF file" << endl;
+                return 1;
+            }
+            opts.icnf_file = argv[i];
+        } else if (arg == "-seed") {
+            if (++i >= argc || !parse_int(argv[i], 0, UINT32_MAX, &value)) {
+                cerr << "Error: please provide the value of the seed flag (int)" << endl;
+                return 1;
+            }
+            opts.seed = value;
+        } else if (arg == "-all") {
+            // Enumerates every model
+            opts.enumerate = true;
+        } else if (arg == "-models") {
+            // Enumerates at most this many models
+            if (++i >= argc || !parse_int(argv[i], 1, LLONG_MAX, &value)) {
+                cerr << "Error: please provide a positive number of models" << endl;
+                return 1;
+            }
+            opts.enumerate = true;
+            opts.max_models = value;
+        } else if (arg == "-project") {
+            // Variables the enumerated models are projected onto
+            if (++i >= argc || !parse_var_list(argv[i], &opts.projection)) {
+                cerr << "Error: please provide the projection as a list of variables, such as 1,4-8,12" << endl;
+                return 1;
+            }
+        } else if (arg == "-count") {
+            // Exact model counting
+            opts.count = true;
+        } else if (arg == "-count-cache") {
+            // Size of the component cache in MB
+            if (++i >= argc || !parse_int(argv[i], 1, LLONG_MAX, &value)) {
+                cerr << "Error: please provide a positive cache size in MB" << endl;
+                return 1;
+            }
+            opts.count_cache_mb = value;
+        } else if (arg == "-core") {
+            // Prints an unsatisfiable subset of the clauses
+            opts.core = true;
+        } else if (arg == "-mus") {
+            // Minimizes the unsatisfiable subset
+            opts.core = true;
+            opts.minimize_core = true;
+        } else if (arg == "-backbone") {
+            // Prints the literals true in every model
+            opts.backbone = true;
+        } else if (arg == "-backbone-chunk") {
+            // Candidate literals tested per solver call
+            if (++i >= argc || !parse_int(argv[i], 1, INT_MAX, &value)) {
+                cerr << "Error: please provide a positive chunk size" << endl;
+                return 1;
+            }
+            opts.backbone = true;
+            opts.backbone_chunk = value;
+        } else if (arg == "-maxsat") {
+            // Reads the file as weighted CNF, implied by the .wcnf extension
+            opts.maxsat = true;
+        } else if (arg == "-proof") {
+            // Writes a DRAT proof when the formula is unsatisfiable
+            if (++i >= argc) {
+                cerr << "Error: please provide the name of the proof file" << endl;
+                return 1;
+            }
+            opts.proof_file = argv[i];
+        } else if (arg == "-proof-text") {
+            // Writes the proof as text instead of binary DRAT
+            opts.proof_binary = false;
+        } else if (arg == "-check-proof") {
+            // Checks a DRAT proof of the formula instead of solving it
+            if (++i >= argc) {
+                cerr << "Error: please provide the name of the proof file to check" << endl;
+                return 1;
+            }
+            opts.check_proof_file = argv[i];
+        } else if (arg == "-lrat") {
+            // Writes the checked proof in LRAT
+            if (++i >= argc) {
+                cerr << "Error: please provide the name of the LRAT file" << endl;
+                return 1;
+            }
+            opts.lrat_file = argv[i];
+        } else if (arg == "-generate") {
+            // Solves a generated instance of a family instead of a file
+            if (i + 2 >= argc || !parse_int(argv[i + 2], 1, INT_MAX, &value)) {
+                cerr << "Error: please provide a generator family and a positive size" << endl;
+                return 1;
+            }
+            gen.family = argv[i + 1];
+            gen.size = value;
+            i += 2;
+        } else if (arg == "-gen-k") {
+            // Literals per clause of random k-SAT
+            if (++i >= argc || !parse_int(argv[i], 1, INT_MAX, &value)) {
+                cerr << "Error: please provide a positive clause length" << endl;
+                return 1;
+            }
+            gen.k = value;
+        } else if (arg == "-gen-ratio") {
+            // Clauses per variable, or edges per vertex for coloring
+            if (++i >= argc || !parse_positive(argv[i], &gen.ratio)) {
+                cerr << "Error: please provide a positive ratio" << endl;
+                return 1;
+            }
+        } else if (arg == "-gen-colors") {
+            if (++i >= argc || !parse_int(argv[i], 1, INT_MAX, &value)) {
+                cerr << "Error: please provide a positive number of colors" << endl;
+                return 1;
+            }
+            gen.colors = value;
+        } else if (arg == "-gen-out") {
+            // Writes the generated instance in DIMACS format instead of solving it
+            if (++i >= argc) {
+                cerr << "Error: please provide the name of the output file" << endl;
+                return 1;
+            }
+            gen_file = argv[i];
+        } else if (arg == "-benchmark") {
+            // Runs a directory or manifest of instances and reports their timings
+            if (++i >= argc) {
+                cerr << "Error: please provide a directory or manifest of instances" << endl;
+                return 1;
+            }
+            bench.target = argv[i];
+        } else if (arg == "-bench-reps") {
+            if (++i >= argc || !parse_int(argv[i], 1, INT_MAX, &value)) {
+                cerr << "Error: please provide a positive number of repetitions" << endl;
+                return 1;
+            }
+            bench.repetitions = value;
+        } else if (arg == "-bench-json" || arg == "-bench-csv" || arg == "-bench-baseline") {
+            if (++i >= argc) {
+                cerr << "Error: please provide the name of the " << arg.substr(7) << " file" << endl;
+                return 1;
+            }
+            string &file = arg == "-bench-json" ? bench.json_file : arg == "-bench-csv" ? bench.csv_file : bench.baseline_file;
+            file = argv[i];
+        } else if (arg == "-batch") {
+            // Solves every file name given, on -threads worker threads
+            batch_mode = true;
+        } else if (arg == "-batch-list") {
+            // Directory of .cnf files or file listing the files to solve, one per line
+            if (++i >= argc) {
+                cerr << "Error: please provide a directory or list of files" << endl;
+                return 1;
+            }
+            batch_mode = true;
+            batch.list_file = argv[i];
+        } else if (arg == "-batch-order") {
+            // Prints the results in the order of the input or as the jobs complete
+            if (++i >= argc || (strcmp(argv[i], "input") != 0 && strcmp(argv[i], "completion") != 0)) {
+                cerr << "Error: please provide the batch order, input or completion" << endl;
+                return 1;
+            }
+            batch.completion_order = strcmp(argv[i], "completion") == 0;
+        } else if (arg == "-server") {
+            // Serves requests on a Unix domain socket instead of solving a file
+            if (++i >= argc) {
+                cerr << "Error: please provide the path of the socket" << endl;
+                return 1;
+            }
+            socket_path = argv[i];
+        } else if (arg == "-time-limit") {
+            // Wall time in seconds
+            if (++i >= argc || !parse_positive(argv[i], &seconds)) {
+                cerr << "Error: please provide a positive time limit in seconds" << endl;
+                return 1;
+            }
+            opts.limits.time_limit = seconds;
+        } else if (arg == "-progress") {
+            // Seconds between progress lines
+            if (++i >= argc || !parse_positive(argv[i], &seconds)) {
+                cerr << "Error: please provide a positive progress interval in seconds" << endl;
+                return 1;
+            }
+            opts.progress_interval = seconds;
+        } else if (arg == "-checkpoint") {
+            // Saves the state of the search to this file
+            if (++i >= argc) {
+                cerr << "Error: please provide the path of the checkpoint file" << endl;
+                return 1;
+            }
+            opts.checkpoint_file = argv[i];
+        } else if (arg == "-checkpoint-interval") {
+            // Seconds between checkpoints
+            if (++i >= argc || !parse_positive(argv[i], &seconds)) {
+                cerr << "Error: please provide a positive checkpoint interval in seconds" << endl;
+                return 1;
+            }
+            opts.checkpoint_interval = seconds;
+        } else if (arg == "-resume") {
+            // Continues the search saved in this file
+            if (++i >= argc) {
+                cerr << "Error: please provide the path of the checkpoint to resume" << endl;
+                return 1;
+            }
+            opts.resume_file = argv[i];
+        } else if (arg == "-trace") {
+            // Chrome trace-event JSON of the hot paths, in builds made with 'make trace'
+            if (++i >= argc) {
+                cerr << "Error: please provide the path of the trace file" << endl;
+                return 1;
+            }
+            trace_file = argv[i];
+        } else if (arg == "-stats") {
+            // Prints the search statistics at the end
+            opts.stats = true;
+        } else if (arg == "-decision-limit") {
+            if (++i >= argc || !parse_int(argv[i], 1, LLONG_MAX, &value)) {
+                cerr << "Error: please provide a positive decision limit" << endl;
+                return 1;
+            }
+            opts.limits.max_decisions = value;
+        } else if (arg == "-propagation-limit") {
+            if (++i >= argc || !parse_int(argv[i], 1, LLONG_MAX, &value)) {
+                cerr << "Error: please provide a positive propagation limit" << endl;
+                return 1;
+            }
+            opts.limits.max_propagations = value;
+        } else if (arg == "-memory-limit") {
+            // Resident memory in MB
+            if (++i >= argc || !parse_int(argv[i], 1, LLONG_MAX, &value)) {
+                cerr << "Error: please provide a positive memory limit in MB" << endl;
+                return 1;
+            }
+            opts.limits.max_memory_mb = value;
+        } else {
+            // File name
+            file_name = arg;
+            batch.files.push_back(arg);
+        }
+    }
+
+    // Weighted CNF files are solved as MaxSAT
+    if (file_name.size() > 5 && file_name.compare(file_name.size() - 5, 5, ".wcnf") == 0) opts.maxsat = true;
+
+    if ((opts.num_threads > 1 || opts.cube_count > 0) + (opts.portfolio_size > 1) + (opts.cdcl_threads > 0) + opts.enumerate + opts.count + opts.maxsat + opts.core + opts.backbone > 1) {
+        cerr << "Error: -portfolio, -cdcl, -all/-models, -count, -maxsat, -core/-mus and -backbone cannot be combined with each other, -threads or -cubes." << endl;
+        return 1;
+    }
+    if (!opts.proof_file.empty() && (opts.num_threads > 1 || opts.cube_count > 0 || opts.portfolio_size > 1 || opts.cdcl_threads > 1 ||
+                                     opts.enumerate || opts.count || opts.maxsat || opts.core || opts.backbone)) {
+        cerr << "Error: -proof only works with the default search or -cdcl 1." << endl;
+        return 1;
+    }
+    if ((!opts.checkpoint_file.empty() || !opts.resume_file.empty()) &&
+        (opts.num_threads > 1 || opts.cube_count > 0 || opts.portfolio_size > 1 || opts.cdcl_threads > 1 || opts.enumerate ||
+         opts.count || opts.maxsat || opts.core || opts.backbone || !opts.proof_file.empty() || !opts.check_proof_file.empty())) {
+        cerr << "Error: -checkpoint and -resume only work with the default search or -cdcl 1, without -proof." << endl;
+        return 1;
+    }
+    if (!opts.lrat_file.empty() && opts.check_proof_file.empty()) {
+        cerr << "Error: -lrat requires -check-proof." << endl;
+        return 1;
+    }
+    if (!opts.check_proof_file.empty() && (!opts.proof_file.empty() || opts.enumerate || opts.count || opts.maxsat || opts.core || opts.backbone)) {
+        cerr << "Error: -check-proof cannot be combined with -proof, -all/-models, -count, -maxsat, -core/-mus or -backbone." << endl;
+        return 1;
+    }
+    if (!opts.projection.empty() && !opts.enumerate) {
+        cerr << "Error: -project requires -all or -models." << endl;
+        return 1;
+    }
+
+    if (!socket_path.empty()) {
+        if (test_val != 0 || !file_name.empty() || batch_mode || !gen.family.empty() || opts.portfolio_size > 1 || opts.cdcl_threads > 0 || opts.cube_count > 0 ||
+            opts.enumerate || opts.count || opts.maxsat || opts.core || opts.backbone || !opts.proof_file.empty() ||
+            !opts.check_proof_file.empty()) {
+            cerr << "Error: -server only takes -threads and the limits." << endl;
+            return 1;
+        }
+        // Ctrl-C finishes the running requests with s UNKNOWN and removes the socket
+        opts.limits.terminate = &interrupted;
+        signal(SIGINT, handle_interrupt);
+        signal(SIGTERM, handle_interrupt);
+        return run_server(socket_path, opts.num_threads, opts.limits);
+    }
+
+    if (!bench.target.empty()) {
+        if (test_val != 0 || !file_name.empty() || batch_mode || !gen.family.empty() || opts.enumerate || opts.count || opts.maxsat ||
+            opts.core || opts.backbone || !opts.proof_file.empty() || !opts.check_proof_file.empty()) {
+            cerr << "Error: -benchmark only takes the options of the decision search and the limits." << endl;
+            return 1;
+        }
+        for (int i = 0; i < argc; i++) bench.command += (i > 0 ? " " : "") + string(argv[i]);
+
+        // Ctrl-C ends the benchmark after the current run, keeping the reports of the instances done
+        opts.limits.terminate = &interrupted;
+        signal(SIGINT, handle_interrupt);
+        signal(SIGTERM, handle_interrupt);
+        return run_benchmark(bench, opts);
+    }
+    if (batch_mode) {
+        if (test_val != 0 || !gen.family.empty() || opts.cube_count > 0 || opts.portfolio_size > 1 ||
+            opts.cdcl_threads > 1 || opts.enumerate || opts.count || opts.maxsat || opts.core || opts.backbone ||
+            !opts.proof_file.empty() || !opts.check_proof_file.empty() || !opts.checkpoint_file.empty() || !opts.resume_file.empty()) {
+            cerr << "Error: -batch only takes the default search or -cdcl 1, -threads and the limits." << endl;
+            return 1;
+        }
+        if (batch.files.empty() && batch.list_file.empty()) {
+            cerr << "Error: please provide the files of the batch." << endl;
+            return 1;
+        }
+        // Each job is single-threaded; -threads is the number of jobs run at once
+        batch.num_workers = opts.num_threads;
+        opts.num_threads = 1;
+
+        // Ctrl-C stops the running jobs with s UNKNOWN, and the remaining ones as soon as they start
+        opts.limits.terminate = &interrupted;
+        signal(SIGINT, handle_interrupt);
+        signal(SIGTERM, handle_interrupt);
+        return run_batch(batch, opts);
+    }
+    if (batch.completion_order) {
+        cerr << "Error: -batch-order requires -batch or -batch-list." << endl;
+        return 1;
+    }
+    if (bench.repetitions != 1 || !bench.json_file.empty() || !bench.csv_file.empty() || !bench.baseline_file.empty()) {
+        cerr << "Error: -bench-reps, -bench-json, -bench-csv and -bench-baseline require -benchmark." << endl;
+        return 1;
+    }
+
+    // Check that exactly one of test flag, generator or file name was specified
+    if ((test_val != 0) + !gen.family.empty() + !file_name.empty() != 1) {
+        cerr << "Error: please specify one of a test flag, a generator or a file name." << endl;
+        return 1;
+    }
+    if (!gen_file.empty() && gen.family.empty()) {
+        cerr << "Error: -gen-out requires -generate." << endl;
+        return 1;
+    }
+    if (!gen.family.empty() && opts.maxsat) {
+        cerr << "Error: -maxsat needs a weighted CNF file." << endl;
+        return 1;
+    }
+    if (!trace_file.empty() && !start_trace(trace_file)) return 1;
+
+    if (test_val != 0) {
+        if (test_val < 0) {
+            cerr << "Error: test flag must be higher than 0" << endl;
+            return 1;
+        }
+        // run test
+        test(test_val);
+    } else if (!gen.family.empty()) {
+        gen.seed = opts.seed;
+        int n;
+        Clause **clause_set = generate_instance(gen, &n, &opts.num_vars);
+        if (clause_set == NULL) return 1;
+
+        if (!gen_file.empty()) {
+            bool written = write_cnf_file(clause_set, n, opts.num_vars, gen_file);
+            free_clause_set(clause_set, n);
+            if (!written) return 1;
+            cout << "c Wrote " << n << " clauses over " << opts.num_vars << " variables to " << gen_file << endl;
+            return 0;
+        }
+
+        opts.limits.terminate = &interrupted;
+        signal(SIGINT, handle_interrupt);
+        signal(SIGTERM, handle_interrupt);
+        // kill -USR1 prints a progress line
+        signal(SIGUSR1, handle_stats_request);
+
+        cout << "c Solving generated " << gen.family << " " << gen.size << endl;
+        solve(clause_set, n, opts);
+    } else {
+        // prove CNF formula from file
+        int n;
+        Clause **clause_set;
+        // Sparse variable ids are compacted for the searches that only print a model, which gets the original ids back
+        bool compact = !opts.enumerate && !opts.count && !opts.core && !opts.backbone && opts.icnf_file.empty() &&
+                       opts.proof_file.empty() && opts.check_proof_file.empty();
+        if (opts.maxsat) clause_set = read_wcnf_file(file_name, &n, &opts.weights, &opts.num_vars);
+        else clause_set = read_cnf_file(file_name, &n, &opts.num_vars, compact ? &opts.var_names : NULL);
+        if (clause_set == NULL) {
+            cerr << "Error: cannot read " << file_name << endl;
+            return 1;
+        }
+
+        // Ctrl-C ends the search with s UNKNOWN instead of killing it
+        opts.limits.terminate = &interrupted;
+        signal(SIGINT, handle_interrupt);
+        signal(SIGTERM, handle_interrupt);
+        // kill -USR1 prints a progress line
+        signal(SIGUSR1, handle_stats_request);
+
+        cout << "c Solving " << file_name << endl;
+        if (!opts.var_names.empty())
+            cout << "c Renumbered " << search_vars(opts.var_names, opts.num_vars) << " variables with ids up to " << opts.var_names.back() << endl;
+        solve(clause_set, n, opts);
+    }
+
+    finish_trace();
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,220 @@
+#include <algorithm>
+#include "maxsat.hpp"
+
+MaxSatSolver::MaxSatSolver(Clause **clause_set, int n, const vector<uint64_t> &weights, uint32_t num_vars, SearchBudget *budget) {
+    for (int i = 0; i < n; i++)
+        for (int j = 0; j < clause_set[i]->n; j++)
+            num_vars = max(num_vars, clause_set[i]->literals[j].var);
+    this->num_vars = num_vars;
+    next_var = num_vars;
+    solver.ensure_vars(num_vars);
+    solver.budget = budget;
+
+    for (int i = 0; i < n; i++) {
+        vector<uint32_t> lits;
+        for (int j = 0; j < clause_set[i]->n; j++)
+            lits.push_back(mk_lit(clause_set[i]->literals[j].var, clause_set[i]->literals[j].positive));
+
+        if (weights[i] == 0) {
+            if (!solver.add_clause(lits)) hard_unsat = true;
+            continue;
+        }
+
+        soft.push_back(lits);
+        soft_weight.push_back(weights[i]);
+        if (lits.empty()) {
+            // Violated by every assignment
+            lower_bound += weights[i];
+        } else if (lits.size() == 1) {
+            // A unit soft clause is its own assumption
+            weight[lits[0]] += weights[i];
+        } else {
+            uint32_t relax = new_var();
+            lits.push_back(mk_lit(relax, true));
+            solver.add_clause(lits);
+            weight[mk_lit(relax, false)] += weights[i];
+        }
+    }
+}
+
+uint32_t MaxSatSolver::new_var() {
+    solver.ensure_vars(++next_var);
+    return next_var;
+}
+
+/**
+ * Encodes the totalizer of inputs[begin .. end-1] as a balanced tree of unary adders.
+ * Only the direction from inputs to outputs is needed, as outputs are only ever assumed false.
+*/
+vector<uint32_t> MaxSatSolver::build_totalizer(const vector<uint32_t> &inputs, size_t begin, size_t end) {
+    if (end - begin == 1) return vector<uint32_t>(1, inputs[begin]);
+
+    size_t mid = (begin + end) / 2;
+    vector<uint32_t> left = build_totalizer(inputs, begin, mid);
+    vector<uint32_t> right = build_totalizer(inputs, mid, end);
+
+    vector<uint32_t> outputs;
+    for (size_t k = 0; k < left.size() + right.size(); k++)
+        outputs.push_back(mk_lit(new_var(), true));
+
+    // i of the left and j of the right inputs true imply at least i+j true
+    for (size_t i = 0; i <= left.size(); i++) {
+        for (size_t j = 0; j <= right.size(); j++) {
+            if (i + j == 0) continue;
+            vector<uint32_t> clause;
+            if (i > 0) clause.push_back(left[i-1] ^ 1);
+            if (j > 0) clause.push_back(right[j-1] ^ 1);
+            clause.push_back(outputs[i+j-1]);
+            solver.add_clause(clause);
+        }
+    }
+    return outputs;
+}
+
+/**
+ * Relaxes a core: the lower bound rises by the smallest weight in it, which is taken off each
+ * of its assumptions and put on a new totalizer bound allowing one of them to be violated.
+ * A totalizer bound in the core is replaced by the next weaker bound of the same totalizer.
+*/
+void MaxSatSolver::process_core(const vector<uint32_t> &core) {
+    uint64_t min_weight = UINT64_MAX;
+    for (uint32_t a : core) min_weight = min(min_weight, weight[a]);
+    lower_bound += min_weight;
+    cores++;
+
+    vector<uint32_t> violated;
+    for (uint32_t a : core) {
+        violated.push_back(a ^ 1);
+
+        auto bound = bound_of.find(a);
+        if (bound != bound_of.end()) {
+            int t = bound->second.first;
+            uint32_t allowed = bound->second.second + 1;
+            if (allowed < totalizers[t].outputs.size()) {
+                uint32_t next = totalizers[t].outputs[allowed] ^ 1;
+                weight[next] += min_weight;
+                bound_of[next] = {t, allowed};
+            }
+        }
+
+        weight[a] -= min_weight;
+        if (weight[a] == 0) {
+            weight.erase(a);
+            bound_of.erase(a);
+        }
+    }
+
+    if (violated.size() > 1) {
+        Totalizer tot;
+        tot.outputs = build_totalizer(violated, 0, violated.size());
+        totalizers.push_back(tot);
+
+        // At least one of the core is violated; assume no more than one
+        uint32_t at_most_one = tot.outputs[1] ^ 1;
+        weight[at_most_one] += min_weight;
+        bound_of[at_most_one] = {(int)totalizers.size() - 1, 1};
+    }
+}
+
+/**
+ * Evaluates the model of the last satisfiable call on the soft clauses, and keeps it if it is the best so far.
+*/
+void MaxSatSolver::check_model() {
+    uint64_t cost = 0;
+    for (size_t i = 0; i < soft.size(); i++) {
+        bool satisfied = false;
+        for (uint32_t lit : soft[i])
+            if (solver.model_value(lit_var(lit)) == lit_positive(lit)) satisfied = true;
+        if (!satisfied) cost += soft_weight[i];
+    }
+
+    if (cost < upper_bound) {
+        upper_bound = cost;
+        best_model.clear();
+        for (uint32_t v = 1; v <= num_vars; v++)
+            best_model.push_back({v, solver.model_value(v)});
+        cout << "o " << cost << endl;
+    }
+}
+
+/**
+ * Searches for a model of the hard clauses of minimum cost. Assumptions are introduced by
+ * decreasing weight: each satisfiable call lowers the weight threshold to the next stratum.
+*/
+int MaxSatSolver::solve() {
+    if (hard_unsat) return MAXSAT_UNSAT;
+
+    uint64_t threshold = 0;
+    for (auto const& [lit, w] : weight) threshold = max(threshold, w);
+
+    for (;;) {
+        vector<uint32_t> assumptions;
+        for (auto const& [lit, w] : weight)
+            if (w >= threshold) assumptions.push_back(lit);
+
+        int res = solver.solve(assumptions);
+        if (res == CDCL_UNKNOWN) break;
+
+        if (res == CDCL_SAT) {
+            check_model();
+            if (upper_bound <= lower_bound) return MAXSAT_OPTIMUM;
+
+            // Next stratum
+            uint64_t next = 0;
+            for (auto const& [lit, w] : weight)
+                if (w < threshold) next = max(next, w);
+            if (next == 0) return MAXSAT_OPTIMUM;
+            threshold = next;
+            continue;
+        }
+
+        // Without assumptions in the core, the hard clauses themselves are unsatisfiable
+        if (solver.failed().empty()) return MAXSAT_UNSAT;
+        process_core(solver.failed());
+        cout << "c lower bound " << lower_bound << " after " << cores << " cores" << endl;
+        if (lower_bound >= upper_bound) return MAXSAT_OPTIMUM;
+    }
+
+    return best_model.empty() ? MAXSAT_UNKNOWN : MAXSAT_SATISFIABLE;
+}
+
+/**
+ * Solves a weighted partial MaxSAT instance, taking ownership of the clause set.
+ * Clauses of weight 0 are hard. Prints an 'o' line whenever a better model is found,
+ * then 's OPTIMUM FOUND' and the model, or the best model if a limit stopped the search.
+ * The model is verified against the hard clauses first, and one that fails is reported as 's UNKNOWN'.
+*/
+int maxsat_solve(Clause **clause_set, int n, const vector<uint64_t> &weights, uint32_t num_vars, SearchBudget *budget) {
+    MaxSatSolver maxsat(clause_set, n, weights, num_vars, budget);
+    vector<Clause*> hard_clauses;
+    for (int i = 0; i < n; i++)
+        if (weights[i] == 0) hard_clauses.push_back(clause_set[i]);
+    CnfFormula hard;
+    build_cnf_formula(hard_clauses.data(), hard_clauses.size(), &hard);
+    free_clause_set(clause_set, n);
+
+    int res = maxsat.solve();
+    if (res == MAXSAT_SATISFIABLE || res == MAXSAT_UNKNOWN) {
+        cout << "c Stopped: " << budget->reason() << " after " << budget->elapsed() << " s" << endl;
+    }
+
+    vector<literal> model = maxsat.model();
+    if ((res == MAXSAT_OPTIMUM || res == MAXSAT_SATISFIABLE) && !check_model(hard, num_vars, &model)) {
+        cout << "s UNKNOWN" << endl;
+        return MAXSAT_UNKNOWN;
+    }
+
+    if (res == MAXSAT_OPTIMUM) {
+        cout << "s OPTIMUM FOUND" << endl;
+        print_model(model);
+    } else if (res == MAXSAT_SATISFIABLE) {
+        cout << "s SATISFIABLE" << endl;
+        print_model(model);
+    } else if (res == MAXSAT_UNSAT) {
+        cout << "s UNSATISFIABLE" << endl;
+    } else {
+        cout << "s UNKNOWN" << endl;
+    }
+
+    return res;
+}
@@ -0,0 +1,62 @@
+#ifndef MAXSAT_H
+#define MAXSAT_H
+
+#include "SAT-solver.hpp"
+#include "cdcl.hpp"
+
+enum maxsat_result {
+    MAXSAT_UNSAT,
+    // Best model found so far, not proven optimal
+    MAXSAT_SATISFIABLE,
+    MAXSAT_OPTIMUM,
+    MAXSAT_UNKNOWN
+};
+
+/**
+ * Totalizer over the violation literals of a core: outputs[j-1] is implied
+ * when at least j of the inputs are true.
+*/
+struct Totalizer {
+    vector<uint32_t> outputs;
+};
+
+/**
+ * Core-guided weighted partial MaxSAT solver (OLL with stratification, in the style of RC2).
+ * Soft clauses are relaxed with one assumption each. Every core found under the assumptions
+ * raises the lower bound by its minimum weight, which is taken off its assumptions and moved
+ * onto a totalizer bound allowing one more violation among them. Intermediate models found
+ * while the assumptions are added stratum by stratum give upper bounds.
+*/
+class MaxSatSolver {
+    public:
+        MaxSatSolver(Clause **clause_set, int n, const vector<uint64_t> &weights, uint32_t num_vars, SearchBudget *budget);
+        int solve();
+        uint64_t cost() { return upper_bound; }
+        const vector<literal> &model() { return best_model; }
+    private:
+        CdclSolver solver;
+        uint32_t num_vars;
+        uint32_t next_var;
+        bool hard_unsat = false;
+        // Soft clauses over literal codes, for evaluating the cost of models
+        vector<vector<uint32_t>> soft;
+        vector<uint64_t> soft_weight;
+        // Remaining weight of each assumption
+        map<uint32_t, uint64_t> weight;
+        // Assumptions bounding a totalizer: the totalizer and the number of violations allowed
+        map<uint32_t, pair<int, uint32_t>> bound_of;
+        vector<Totalizer> totalizers;
+        uint64_t lower_bound = 0;
+        uint64_t upper_bound = UINT64_MAX;
+        vector<literal> best_model;
+        uint64_t cores = 0;
+
+        uint32_t new_var();
+        vector<uint32_t> build_totalizer(const vector<uint32_t> &inputs, size_t begin, size_t end);
+        void process_core(const vector<uint32_t> &core);
+        void check_model();
+};
+
+int maxsat_solve(Clause **clause_set, int n, const vector<uint64_t> &weights, uint32_t num_vars, SearchBudget *budget);
+
+#endif
@@ -0,0 +1,49 @@
+#include <atomic>
+#include <iostream>
+#include <sstream>
+#include "memory.hpp"
+#include "stats.hpp"
+
+static const char *CATEGORY_NAMES[MEM_CATEGORIES] = {"clauses", "sequent copies", "heuristics", "CDCL"};
+
+// Bytes held by each category, and the most they held at once. Updated once per sequent or
+// clause database change, not per clause, so the shared counters see little traffic.
+static atomic<uint64_t> held[MEM_CATEGORIES];
+static atomic<uint64_t> peak[MEM_CATEGORIES];
+static atomic<uint64_t> held_total{0};
+static atomic<uint64_t> peak_total{0};
+
+static void raise_peak(atomic<uint64_t> *peak, uint64_t value) {
+    uint64_t seen = peak->load(memory_order_relaxed);
+    while (value > seen && !peak->compare_exchange_weak(seen, value, memory_order_relaxed)) {}
+}
+
+void memory_add(memory_category category, uint64_t bytes) {
+    raise_peak(&peak[category], held[category].fetch_add(bytes, memory_order_relaxed) + bytes);
+    raise_peak(&peak_total, held_total.fetch_add(bytes, memory_order_relaxed) + bytes);
+}
+
+void memory_release(memory_category category, uint64_t bytes) {
+    held[category].fetch_sub(bytes, memory_order_relaxed);
+    held_total.fetch_sub(bytes, memory_order_relaxed);
+}
+
+/**
+ * Bytes held by all accounted subsystems together.
+*/
+uint64_t tracked_memory_bytes() {
+    return held_total.load(memory_order_relaxed);
+}
+
+/**
+ * Prints the peak of every accounted subsystem and of their sum, and the peak resident memory of the process,
+ * which also counts what is not accounted: the allocator's overhead and free lists, stacks and code.
+*/
+void print_memory_report() {
+    ostringstream out;
+    out << "c   peak memory by subsystem:";
+    for (int i = 0; i < MEM_CATEGORIES; i++)
+        out << (i > 0 ? "," : "") << " " << CATEGORY_NAMES[i] << " " << peak[i].load() / 1024 << " KB";
+    out << "; accounted " << peak_total.load() / 1024 << " KB, resident " << peak_memory_bytes() / 1024 << " KB";
+    cout << out.str() << endl;
+}
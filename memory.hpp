@@ -0,0 +1,25 @@
+#ifndef MEMORY_H
+#define MEMORY_H
+
+#include <cstdint>
+using namespace std;
+
+/**
+ * Subsystems whose heap memory is accounted: the clause set the search starts from, the copies
+ * of the clause set made by the cuts of the sequent search, the occurrence counts and unit
+ * queues of the sequents that guide it, and the clause database of the CDCL solvers.
+*/
+enum memory_category {
+    MEM_CLAUSES,
+    MEM_SEQUENT_COPIES,
+    MEM_HEURISTICS,
+    MEM_CDCL,
+    MEM_CATEGORIES
+};
+
+void memory_add(memory_category category, uint64_t bytes);
+void memory_release(memory_category category, uint64_t bytes);
+uint64_t tracked_memory_bytes();
+void print_memory_report();
+
+#endif
@@ -0,0 +1,185 @@
+#include "parallel.hpp"
+#include "stats.hpp"
+#include "trace.hpp"
+
+void WorkDeque::push_bottom(Sequent *seq) {
+    lock_guard<mutex> guard(lock);
+    sequents.push_back(seq);
+}
+
+Sequent *WorkDeque::pop_bottom() {
+    lock_guard<mutex> guard(lock);
+    if (sequents.empty()) return NULL;
+    Sequent *seq = sequents.back();
+    sequents.pop_back();
+    return seq;
+}
+
+Sequent *WorkDeque::steal_top() {
+    lock_guard<mutex> guard(lock);
+    if (sequents.empty()) return NULL;
+    Sequent *seq = sequents.front();
+    sequents.pop_front();
+    return seq;
+}
+
+void WorkDeque::free_all() {
+    lock_guard<mutex> guard(lock);
+    while (!sequents.empty()) {
+        free_sequent(sequents.back());
+        sequents.pop_back();
+    }
+}
+
+struct ParallelSearch {
+    vector<WorkDeque> deques;
+    // Sequents either queued or being expanded; the search is exhausted when it reaches 0
+    atomic<long> pending{0};
+    atomic<bool> found{false};
+    atomic<long> steals{0};
+    // Idle workers sleep on work_ready until a sequent is pushed or the search ends
+    mutex idle_lock;
+    condition_variable work_ready;
+    atomic<int> idle{0};
+    atomic<uint64_t> pushes{0};
+    mutex model_lock;
+    vector<literal> model;
+    SearchBudget *budget;
+
+    ParallelSearch(int num_threads, SearchBudget *budget) : deques(num_threads), budget(budget) {}
+
+    /**
+     * Wakes idle workers. Taking idle_lock orders the wake-up after their last check.
+    */
+    void wake(bool all) {
+        if (idle.load() == 0) return;
+        lock_guard<mutex> guard(idle_lock);
+        if (all) work_ready.notify_all();
+        else work_ready.notify_one();
+    }
+};
+
+/**
+ * Expands a sequent depth-first, always continuing with the left sequent and
+ * leaving the right sequent of each cut in the worker's deque for itself or for thieves.
+ * Stops at a closed branch, a model, or when another worker has found a model.
+*/
+static void expand(ParallelSearch *search, int id, Sequent *seq, uint64_t *decisions, uint64_t *propagations) {
+    TRACE_SCOPE("expand");
+    while (!search->found.load(memory_order_relaxed) && !search->budget->exhausted(*decisions, *propagations)) {
+        {
+            TRACE_SCOPE("propagate");
+            while (seq->propagate()) (*propagations)++;
+        }
+
+        if (seq->is_axiom()) {
+            count_conflict();
+            break;
+        }
+
+        uint32_t var = choose_cut_var(seq);
+        if (var == 0) {
+            lock_guard<mutex> guard(search->model_lock);
+            if (!search->found.load()) {
+                sequent_model(seq, &search->model);
+                search->found.store(true);
+            }
+            search->wake(true);
+            break;
+        }
+
+        Sequent *left;
+        Sequent *right;
+        apply_atomic_cut(seq, &left, &right, var);
+        free_sequent(seq);
+        (*decisions)++;
+        note_depth(left->depth);
+
+        search->pending.fetch_add(1);
+        search->deques[id].push_bottom(right);
+        search->pushes.fetch_add(1);
+        search->wake(false);
+        seq = left;
+    }
+
+    free_sequent(seq);
+    if (search->pending.fetch_sub(1) == 1 || search->budget->stopped()) search->wake(true);
+}
+
+static void worker(ParallelSearch *search, int id) {
+    int num_threads = search->deques.size();
+    uint32_t rnd = 2463534242u + id;
+    uint64_t decisions = 0;
+    uint64_t propagations = 0;
+
+    while (!search->found.load(memory_order_relaxed) && !search->budget->stopped()) {
+        uint64_t seen = search->pushes.load();
+        Sequent *seq = search->deques[id].pop_bottom();
+
+        if (seq == NULL) {
+            // Own deque is empty, try to steal from a random victim
+            for (int attempt = 0; attempt < num_threads && seq == NULL; attempt++) {
+                rnd ^= rnd << 13;
+                rnd ^= rnd >> 17;
+                rnd ^= rnd << 5;
+                int victim = rnd % num_threads;
+                if (victim == id) continue;
+                seq = search->deques[victim].steal_top();
+            }
+            if (seq != NULL) search->steals.fetch_add(1, memory_order_relaxed);
+        }
+
+        if (seq == NULL) {
+            // Sleeps until new work may be stealable; the timeout keeps polling the budget
+            unique_lock<mutex> guard(search->idle_lock);
+            search->idle.fetch_add(1);
+            search->work_ready.wait_for(guard, chrono::milliseconds(20), [search, seen] {
+                return search->pushes.load() != seen || search->pending.load() == 0 ||
+                       search->found.load() || search->budget->stopped();
+            });
+            search->idle.fetch_sub(1);
+            if (search->pending.load() == 0) break;
+            continue;
+        }
+
+        try {
+            expand(search, id, seq, &decisions, &propagations);
+        } catch (const bad_alloc &) {
+            // The sequents in flight are leaked; the other workers stop at the budget
+            search->budget->trip("out of memory");
+            search->wake(true);
+        }
+    }
+
+    search->budget->add_work(decisions, propagations);
+}
+
+/**
+ * Determines the satisfiability of a sequent with a pool of work-stealing threads.
+ * Every atomic cut produces two independent sequents; workers explore their own subtree
+ * depth-first while idle workers steal unexplored right sequents near the root.
+ * All workers stop as soon as one of them finds a model, which is written to model,
+ * or when the budget is exhausted.
+*/
+bool prove_parallel(Sequent *seq, int num_threads, SearchBudget *budget, vector<literal> *model) {
+    ParallelSearch search(num_threads, budget);
+    search.pending.store(1);
+    search.deques[0].push_bottom(seq);
+
+    vector<thread> threads;
+    for (int i = 0; i < num_threads; i++)
+        threads.push_back(thread(worker, &search, i));
+    for (thread &t : threads)
+        t.join();
+
+    // Frees the sequents left unexplored after cancellation
+    for (WorkDeque &d : search.deques)
+        d.free_all();
+
+    cout << "c Parallel search: " << num_threads << " threads, " << search.steals.load() << " steals" << endl;
+
+    if (!search.found.load()) return 0;
+
+    *model = search.model;
+    return 1;
+}
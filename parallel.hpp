@@ -0,0 +1,29 @@
+#ifndef PARALLEL_H
+#define PARALLEL_H
+
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <deque>
+#include <thread>
+#include "SAT-solver.hpp"
+
+/**
+ * Double-ended queue of open sequents owned by one worker.
+ * The owner pushes and pops at the bottom (depth-first order),
+ * thieves take from the top, where the sequents closest to the root are.
+*/
+class WorkDeque {
+    public:
+        void push_bottom(Sequent *seq);
+        Sequent *pop_bottom();
+        Sequent *steal_top();
+        void free_all();
+    private:
+        mutex lock;
+        deque<Sequent*> sequents;
+};
+
+bool prove_parallel(Sequent *seq, int num_threads, SearchBudget *budget, vector<literal> *model);
+
+#endif
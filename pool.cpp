@@ -0,0 +1,119 @@
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#include "pool.hpp"
+
+const int POOL_CLASSES = POOL_MAX_SIZE / 16;
+// Blocks a free list keeps, beyond which freed blocks go back to malloc
+const uint32_t POOL_MAX_CACHED = 1 << 16;
+
+struct free_block {
+    free_block *next;
+};
+
+// Free lists and counters of a thread. Trivially destructible, so it stays usable
+// while other thread-local and static objects are destroyed.
+struct pool_thread {
+    free_block *lists[POOL_CLASSES];
+    uint32_t cached[POOL_CLASSES];
+    uint64_t allocations;
+    uint64_t reused;
+    // Requests handed on to malloc: misses of the free lists and blocks above POOL_MAX_SIZE
+    uint64_t misses;
+    uint64_t miss_bytes;
+    bool released;
+};
+
+static thread_local pool_thread pool;
+
+// Counters of the threads that have exited
+static atomic<uint64_t> retired_allocations{0};
+static atomic<uint64_t> retired_reused{0};
+static atomic<uint64_t> retired_misses{0};
+static atomic<uint64_t> retired_miss_bytes{0};
+
+/**
+ * Returns the cached blocks of a thread to malloc when the thread exits.
+ * From then on its frees bypass the lists.
+*/
+struct PoolReleaser {
+    bool armed = false;
+    ~PoolReleaser() {
+        for (int c = 0; c < POOL_CLASSES; c++) {
+            while (pool.lists[c] != NULL) {
+                free_block *block = pool.lists[c];
+                pool.lists[c] = block->next;
+                free(block);
+            }
+            pool.cached[c] = 0;
+        }
+        pool.released = true;
+        retired_allocations.fetch_add(pool.allocations);
+        retired_reused.fetch_add(pool.reused);
+        retired_misses.fetch_add(pool.misses);
+        retired_miss_bytes.fetch_add(pool.miss_bytes);
+        pool.allocations = 0;
+        pool.reused = 0;
+        pool.misses = 0;
+        pool.miss_bytes = 0;
+    }
+};
+
+static thread_local PoolReleaser releaser;
+
+void *pool_alloc(size_t size) {
+    if (size == 0) size = 1;
+    if (size > POOL_MAX_SIZE) {
+        pool.misses++;
+        pool.miss_bytes += size;
+        void *p = malloc(size);
+        if (p == NULL) throw bad_alloc();
+        return p;
+    }
+
+    int c = (size - 1) / 16;
+    pool.allocations++;
+    free_block *block = pool.lists[c];
+    if (block != NULL) {
+        pool.lists[c] = block->next;
+        pool.cached[c]--;
+        pool.reused++;
+        return block;
+    }
+
+    // Registers the releaser of the thread with its first fresh block
+    if (!releaser.armed) releaser.armed = true;
+    pool.misses++;
+    pool.miss_bytes += (c + 1) * 16;
+    void *p = malloc((c + 1) * 16);
+    if (p == NULL) throw bad_alloc();
+    return p;
+}
+
+void pool_free(void *p, size_t size) {
+    if (p == NULL) return;
+    if (size == 0) size = 1;
+    int c = (size - 1) / 16;
+    if (size > POOL_MAX_SIZE || pool.released || pool.cached[c] >= POOL_MAX_CACHED) {
+        free(p);
+        return;
+    }
+
+    free_block *block = (free_block*)p;
+    block->next = pool.lists[c];
+    pool.lists[c] = block;
+    pool.cached[c]++;
+    if (!releaser.armed) releaser.armed = true;
+}
+
+/**
+ * Allocation counters of the threads that have exited and of the calling thread.
+*/
+pool_statistics get_pool_statistics() {
+    pool_statistics stats;
+    stats.allocations = retired_allocations.load() + pool.allocations;
+    stats.reused = retired_reused.load() + pool.reused;
+    stats.misses = retired_misses.load() + pool.misses;
+    stats.miss_bytes = retired_miss_bytes.load() + pool.miss_bytes;
+    return stats;
+}
@@ -0,0 +1,48 @@
+#ifndef POOL_H
+#define POOL_H
+
+#include <cstddef>
+#include <cstdint>
+using namespace std;
+
+/**
+ * Per-thread free lists for the small objects of the sequent search: clauses, literal arrays,
+ * sequents and the nodes of their occurrence maps. Blocks are rounded up to size classes of
+ * 16 bytes up to POOL_MAX_SIZE; freed blocks go onto the free list of their class in the freeing
+ * thread and are handed out again, last in first out, so the copies made at one cut reuse the
+ * memory of the sequents just refuted. Larger blocks, and blocks beyond what a list caches, go
+ * to malloc and free. A block may be freed by another thread than the one that allocated it.
+*/
+const size_t POOL_MAX_SIZE = 256;
+
+void *pool_alloc(size_t size);
+void pool_free(void *p, size_t size);
+
+struct pool_statistics {
+    uint64_t allocations = 0;
+    uint64_t reused = 0;
+    // Requests that went to malloc, and their bytes
+    uint64_t misses = 0;
+    uint64_t miss_bytes = 0;
+};
+
+pool_statistics get_pool_statistics();
+
+/**
+ * Standard allocator over the pool, for the containers of the search.
+*/
+template <class T>
+struct PoolAllocator {
+    typedef T value_type;
+
+    PoolAllocator() {}
+    template <class U> PoolAllocator(const PoolAllocator<U> &) {}
+
+    T *allocate(size_t n) { return (T*)pool_alloc(n * sizeof(T)); }
+    void deallocate(T *p, size_t n) { pool_free(p, n * sizeof(T)); }
+
+    template <class U> bool operator==(const PoolAllocator<U> &) const { return true; }
+    template <class U> bool operator!=(const PoolAllocator<U> &) const { return false; }
+};
+
+#endif
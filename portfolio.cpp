@@ -0,0 +1,119 @@
+#include "portfolio.hpp"
+
+static const char *heuristic_names[] = {"most-occurrences", "random-ties", "weighted-random"};
+static const char *polarity_names[] = {"positive", "negative", "random"};
+
+struct Portfolio {
+    Sequent *root;
+    vector<search_context> contexts;
+    atomic<bool> stop{false};
+    // Index of the first solver to finish, or -1
+    atomic<int> winner{-1};
+    bool result = 0;
+};
+
+/**
+ * Returns the configuration of the solver with the given index.
+ * Solver 0 always runs the default configuration of prove(),
+ * the others cycle through every combination of cut heuristic and branch polarity.
+*/
+search_config portfolio_config(int id) {
+    static const cut_heuristic heuristics[] = {
+        CUT_MOST_OCCURRENCES, CUT_MOST_OCCURRENCES_RANDOM_TIES, CUT_WEIGHTED_RANDOM
+    };
+    static const cut_polarity polarities[] = {
+        POLARITY_POSITIVE, POLARITY_NEGATIVE, POLARITY_RANDOM
+    };
+
+    search_config config;
+    config.heuristic = heuristics[id % 3];
+    config.polarity = polarities[(id / 3 + id) % 3];
+    return config;
+}
+
+/**
+ * Runs one solver of the portfolio. The shared root sequent is only read:
+ * the solver's first atomic cut copies the clauses it keeps into sequents of its own.
+*/
+static void portfolio_worker(Portfolio *p, int id) {
+    search_context *ctx = &p->contexts[id];
+    Sequent *root = p->root;
+
+    uint32_t var = choose_cut_var(root, ctx->config, &ctx->rng);
+    bool val = choose_positive_first(ctx->config, &ctx->rng);
+    bool res = 0;
+
+    try {
+        for (int branch = 0; branch < 2 && res == 0; branch++) {
+            Sequent *seq = atomic_cut_create_sequent(root->clause_set, root->n, var, branch == 0 ? val : !val);
+            res = prove(seq, ctx);
+            if (p->stop.load() || ctx->budget->stopped()) break;
+        }
+    } catch (const bad_alloc &) {
+        // Leaks the solver's sequents and stops the others through the budget
+        ctx->budget->trip("out of memory");
+        res = 0;
+    }
+    ctx->budget->add_work(ctx->decisions, ctx->propagations);
+    if (p->stop.load() || (res == 0 && ctx->budget->stopped())) return;
+
+    // First solver to finish decides the formula and cancels the others
+    int expected = -1;
+    if (p->winner.compare_exchange_strong(expected, id)) {
+        p->result = res;
+        p->stop.store(true);
+    }
+}
+
+/**
+ * Determines the satisfiability of a sequent by racing several differently configured
+ * solvers on it, one thread each. Returns the answer of the first solver to finish.
+*/
+bool prove_portfolio(Sequent *root, int num_solvers, uint32_t seed, SearchBudget *budget, vector<literal> *model) {
+    // Simplifies the shared root once, before it becomes read-only
+    while (root->propagate());
+
+    if (root->is_axiom()) {
+        free_sequent(root);
+        return 0;
+    }
+
+    if (choose_cut_var(root) == 0) {
+        sequent_model(root, model);
+        free_sequent(root);
+        return 1;
+    }
+
+    Portfolio p;
+    p.root = root;
+    p.contexts.resize(num_solvers);
+    for (int i = 0; i < num_solvers; i++) {
+        p.contexts[i].config = portfolio_config(i);
+        // Distinct non-zero xorshift states
+        p.contexts[i].rng = (seed + i) * 2654435761u + 2463534242u;
+        if (p.contexts[i].rng == 0) p.contexts[i].rng = 1;
+        p.contexts[i].stop = &p.stop;
+        p.contexts[i].budget = budget;
+    }
+
+    vector<thread> threads;
+    for (int i = 0; i < num_solvers; i++)
+        threads.push_back(thread(portfolio_worker, &p, i));
+    for (thread &t : threads)
+        t.join();
+
+    int w = p.winner.load();
+    if (w < 0) {
+        // Every solver ran out of budget
+        free_sequent(root);
+        return 0;
+    }
+    search_config config = p.contexts[w].config;
+    cout << "c Portfolio: solver " << w << " of " << num_solvers << " finished first ("
+         << heuristic_names[config.heuristic] << ", " << polarity_names[config.polarity] << ")" << endl;
+
+    if (p.result == 1) *model = p.contexts[w].model;
+    free_sequent(root);
+
+    return p.result;
+}
@@ -0,0 +1,11 @@
+#ifndef PORTFOLIO_H
+#define PORTFOLIO_H
+
+#include <thread>
+#include "SAT-solver.hpp"
+
+search_config portfolio_config(int id);
+
+bool prove_portfolio(Sequent *root, int num_solvers, uint32_t seed, SearchBudget *budget, vector<literal> *model);
+
+#endif
@@ -0,0 +1,416 @@
+#include <algorithm>
+#include <cerrno>
+#include <climits>
+#include <unordered_map>
+#include "proof.hpp"
+
+ProofWriter::ProofWriter(string filename, bool binary) : output(filename, ios::binary) {
+    this->binary = binary;
+    buffer = new char[PROOF_BUFFER_SIZE];
+    if (!output) cerr << "Error: cannot open " << filename << endl;
+}
+
+ProofWriter::~ProofWriter() {
+    flush();
+    delete []buffer;
+}
+
+void ProofWriter::flush() {
+    if (used == 0) return;
+    output.write(buffer, used);
+    bytes += used;
+    used = 0;
+}
+
+/**
+ * Appends one clause. In binary, a clause is its tag followed by each literal code as a
+ * little-endian base-128 varint, and a 0 byte; as text, a DIMACS line. The literal code is
+ * written as it is, since mk_lit() already gives binary DRAT's 2 * |l| + sign.
+*/
+void ProofWriter::write_clause(char tag, const uint32_t *lits, size_t size) {
+    // Room for the tag, one literal and the terminator in either encoding
+    const size_t reserve = 16;
+
+    if (used + reserve > PROOF_BUFFER_SIZE) flush();
+    if (binary) {
+        buffer[used++] = tag;
+    } else if (tag == 'd') {
+        buffer[used++] = 'd';
+        buffer[used++] = ' ';
+    }
+
+    for (size_t i = 0; i < size; i++) {
+        if (used + reserve > PROOF_BUFFER_SIZE) flush();
+        if (binary) {
+            uint32_t u = lits[i];
+            while (u > 127) {
+                buffer[used++] = (char)(128 | (u & 127));
+                u >>= 7;
+            }
+            buffer[used++] = (char)u;
+        } else {
+            used += sprintf(buffer + used, "%s%u ", lit_positive(lits[i]) ? "" : "-", lit_var(lits[i]));
+        }
+    }
+
+    if (binary) {
+        buffer[used++] = 0;
+    } else {
+        buffer[used++] = '0';
+        buffer[used++] = '\n';
+    }
+}
+
+struct CheckedClause {
+    // The first two literals are watched
+    vector<uint32_t> lits;
+    uint64_t id;
+    bool active;
+};
+
+/**
+ * Forward DRAT checker. Every lemma is checked against the clauses active at that point,
+ * first by reverse unit propagation, then as a resolution asymmetric tautology on its first literal.
+ * Propagation restarts from an empty assignment for each check, with two watched literals per clause.
+ * Like drat-trim, deletions of unit clauses are ignored.
+*/
+class ProofChecker {
+    public:
+        ProofChecker(Clause **clause_set, int n);
+        bool check(const vector<uint32_t> &lemma, vector<uint64_t> *hints, bool *rat);
+        uint64_t add(const vector<uint32_t> &lits);
+        bool remove(const vector<uint32_t> &lits, uint64_t *id);
+        bool refuted = false;
+    private:
+        vector<CheckedClause> clauses;
+        vector<vector<uint32_t>> watches;
+        vector<uint32_t> units;
+        unordered_map<string, vector<uint32_t>> lookup;
+        vector<int8_t> vals;
+        vector<uint32_t> reason;
+        vector<uint32_t> trail;
+        uint64_t next_id = 1;
+
+        void ensure_lits(const vector<uint32_t> &lits);
+        bool assign(uint32_t lit, uint32_t from, uint32_t *conflict);
+        bool rup(const vector<uint32_t> &lits, vector<uint64_t> *hints);
+};
+
+static string clause_key(vector<uint32_t> lits) {
+    sort(lits.begin(), lits.end());
+    lits.erase(unique(lits.begin(), lits.end()), lits.end());
+    return string((const char *)lits.data(), lits.size() * sizeof(uint32_t));
+}
+
+ProofChecker::ProofChecker(Clause **clause_set, int n) {
+    for (int i = 0; i < n; i++) {
+        vector<uint32_t> lits;
+        for (int j = 0; j < clause_set[i]->n; j++)
+            lits.push_back(mk_lit(clause_set[i]->literals[j].var, clause_set[i]->literals[j].positive));
+        add(lits);
+    }
+}
+
+void ProofChecker::ensure_lits(const vector<uint32_t> &lits) {
+    for (uint32_t lit : lits) {
+        if ((lit | 1) >= vals.size()) {
+            vals.resize((lit | 1) + 1, 0);
+            watches.resize((lit | 1) + 1);
+            reason.resize(lit_var(lit) + 1, CREF_NONE);
+        }
+    }
+}
+
+/**
+ * Adds a clause to the active set, returning its id. Clause ids follow the input order,
+ * then the order of the lemmas, as in LRAT.
+*/
+uint64_t ProofChecker::add(const vector<uint32_t> &lits) {
+    ensure_lits(lits);
+    uint32_t idx = clauses.size();
+    CheckedClause c;
+    c.lits = lits;
+    sort(c.lits.begin(), c.lits.end());
+    c.lits.erase(unique(c.lits.begin(), c.lits.end()), c.lits.end());
+    c.id = next_id++;
+    c.active = true;
+    clauses.push_back(c);
+    lookup[clause_key(c.lits)].push_back(idx);
+
+    if (c.lits.empty()) refuted = true;
+    else if (c.lits.size() == 1) units.push_back(idx);
+    else {
+        watches[c.lits[0]].push_back(idx);
+        watches[c.lits[1]].push_back(idx);
+    }
+    return c.id;
+}
+
+/**
+ * Deactivates a clause with the given literals. Returns false if there is none;
+ * unit clauses are kept, and id is then left at 0.
+*/
+bool ProofChecker::remove(const vector<uint32_t> &lits, uint64_t *id) {
+    *id = 0;
+    auto it = lookup.find(clause_key(lits));
+    if (it == lookup.end() || it->second.empty()) return false;
+
+    uint32_t idx = it->second.back();
+    if (clauses[idx].lits.size() == 1) return true;
+
+    it->second.pop_back();
+    clauses[idx].active = false;
+    *id = clauses[idx].id;
+    return true;
+}
+
+bool ProofChecker::assign(uint32_t lit, uint32_t from, uint32_t *conflict) {
+    if (vals[lit] == 1) return true;
+    if (vals[lit] == -1) {
+        *conflict = from;
+        return false;
+    }
+    vals[lit] = 1;
+    vals[lit ^ 1] = -1;
+    reason[lit_var(lit)] = from;
+    trail.push_back(lit);
+    return true;
+}
+
+/**
+ * Reverse unit propagation: assumes the negation of the clause and propagates the active clauses
+ * to a conflict. On success, hints receives the ids of the clauses used, in LRAT order.
+*/
+bool ProofChecker::rup(const vector<uint32_t> &lits, vector<uint64_t> *hints) {
+    ensure_lits(lits);
+    uint32_t conflict = CREF_NONE;
+    bool ok = false;
+    trail.clear();
+
+    for (size_t i = 0; i < lits.size() && !ok; i++) {
+        // A literal and its negation make the clause a tautology
+        if (!assign(lits[i] ^ 1, CREF_NONE, &conflict)) ok = true;
+    }
+
+    for (size_t i = 0; i < units.size() && !ok; i++)
+        if (!assign(clauses[units[i]].lits[0], units[i], &conflict)) ok = true;
+
+    for (size_t head = 0; head < trail.size() && !ok; head++) {
+        uint32_t falsified = trail[head] ^ 1;
+        vector<uint32_t> &ws = watches[falsified];
+        size_t j = 0;
+        for (size_t i = 0; i < ws.size(); i++) {
+            CheckedClause &c = clauses[ws[i]];
+            if (!c.active) continue;
+            if (ok) {
+                ws[j++] = ws[i];
+                continue;
+            }
+
+            if (c.lits[0] == falsified) swap(c.lits[0], c.lits[1]);
+            if (vals[c.lits[0]] == 1) {
+                ws[j++] = ws[i];
+                continue;
+            }
+
+            bool moved = false;
+            for (size_t k = 2; k < c.lits.size(); k++) {
+                if (vals[c.lits[k]] != -1) {
+                    swap(c.lits[1], c.lits[k]);
+                    watches[c.lits[1]].push_back(ws[i]);
+                    moved = true;
+                    break;
+                }
+            }
+            if (moved) continue;
+
+            ws[j++] = ws[i];
+            if (!assign(c.lits[0], ws[i], &conflict)) ok = true;
+        }
+        ws.resize(j);
+    }
+
+    if (ok && hints != NULL) {
+        // Walks back from the conflict to the reasons it depends on
+        hints->clear();
+        if (conflict != CREF_NONE) {
+            vector<char> needed(reason.size(), 0);
+            for (uint32_t lit : clauses[conflict].lits) needed[lit_var(lit)] = 1;
+            vector<uint64_t> chain;
+            for (size_t i = trail.size(); i > 0; i--) {
+                uint32_t v = lit_var(trail[i-1]);
+                if (!needed[v] || reason[v] == CREF_NONE) continue;
+                chain.push_back(clauses[reason[v]].id);
+                for (uint32_t lit : clauses[reason[v]].lits) needed[lit_var(lit)] = 1;
+            }
+            hints->assign(chain.rbegin(), chain.rend());
+            hints->push_back(clauses[conflict].id);
+        }
+    }
+
+    for (uint32_t lit : trail) {
+        vals[lit] = 0;
+        vals[lit ^ 1] = 0;
+        reason[lit_var(lit)] = CREF_NONE;
+    }
+    return ok;
+}
+
+/**
+ * Checks a lemma. A lemma that is not a reverse unit propagation is checked as a resolution
+ * asymmetric tautology on its first literal, in which case rat is set and no hints are given.
+*/
+bool ProofChecker::check(const vector<uint32_t> &lemma, vector<uint64_t> *hints, bool *rat) {
+    *rat = false;
+    if (rup(lemma, hints)) return true;
+    if (lemma.empty()) return false;
+
+    *rat = true;
+    uint32_t pivot = lemma[0];
+    for (CheckedClause &c : clauses) {
+        if (!c.active || find(c.lits.begin(), c.lits.end(), pivot ^ 1) == c.lits.end()) continue;
+
+        vector<uint32_t> resolvent = lemma;
+        bool tautology = false;
+        for (uint32_t lit : c.lits) {
+            if (lit == (pivot ^ 1)) continue;
+            if (find(lemma.begin(), lemma.end(), lit ^ 1) != lemma.end()) tautology = true;
+            resolvent.push_back(lit);
+        }
+        if (!tautology && !rup(resolvent, NULL)) return false;
+    }
+    return true;
+}
+
+/**
+ * Reads the next step of a proof: 'a' and the lemma, or 'd' and the deleted clause.
+ * Returns 0 at the end of the proof, and 'e' for a text token that is not a literal,
+ * leaving pos at its offset.
+*/
+static char next_step(const string &proof, size_t *pos, bool binary, vector<uint32_t> *lits) {
+    lits->clear();
+    if (binary) {
+        if (*pos >= proof.size()) return 0;
+        char tag = proof[(*pos)++];
+        for (;;) {
+            uint32_t u = 0;
+            int shift = 0;
+            unsigned char b;
+            do {
+                if (*pos >= proof.size()) return 0;
+                b = proof[(*pos)++];
+                u |= (uint32_t)(b & 127) << shift;
+                shift += 7;
+            } while (b & 128);
+            if (u == 0) return tag;
+            lits->push_back(u);
+        }
+    }
+
+    char tag = 'a';
+    bool started = false;
+    while (*pos < proof.size()) {
+        char ch = proof[*pos];
+        if (isspace((unsigned char)ch)) {
+            (*pos)++;
+        } else if (ch == 'c' && !started) {
+            while (*pos < proof.size() && proof[*pos] != '\n') (*pos)++;
+        } else if (ch == 'd' && !started) {
+            tag = 'd';
+            started = true;
+            (*pos)++;
+        } else {
+            const char *token = proof.c_str() + *pos;
+            char *end;
+            errno = 0;
+            long lit = strtol(token, &end, 10);
+            if (end == token || errno != 0 || labs(lit) > INT32_MAX || (*end != '\0' && !isspace((unsigned char)*end)))
+                return 'e';
+            *pos += end - token;
+            started = true;
+            if (lit == 0) return tag;
+            lits->push_back(mk_lit(labs(lit), lit > 0));
+        }
+    }
+    return 0;
+}
+
+/**
+ * Checks a DRAT proof, binary or text, of the unsatisfiability of a clause set.
+ * With lrat_file, also writes the proof in LRAT with the hints found while checking.
+ * Prints 's VERIFIED' or 's NOT VERIFIED'.
+*/
+bool check_proof(Clause **clause_set, int n, string proof_file, string lrat_file) {
+    ifstream input(proof_file, ios::binary);
+    if (!input) {
+        cerr << "Error: cannot open " << proof_file << endl;
+        return false;
+    }
+    stringstream contents;
+    contents << input.rdbuf();
+    string proof = contents.str();
+
+    // Text proofs never contain a 0 byte, binary ones end every clause with one
+    bool binary = proof.find('\0') != string::npos;
+
+    ofstream lrat;
+    if (!lrat_file.empty()) lrat.open(lrat_file);
+
+    ProofChecker checker(clause_set, n);
+    uint64_t last_id = n;
+    uint64_t lemmas = 0;
+    uint64_t deletions = 0;
+    uint64_t ignored = 0;
+    bool verified = checker.refuted;
+
+    size_t pos = 0;
+    vector<uint32_t> lits;
+    vector<uint64_t> hints;
+    while (!verified) {
+        char tag = next_step(proof, &pos, binary, &lits);
+        if (tag == 0) break;
+        if (tag == 'e') {
+            cout << "c Malformed proof: no literal at byte " << pos << endl;
+            break;
+        }
+
+        if (tag == 'd') {
+            uint64_t id;
+            if (!checker.remove(lits, &id)) ignored++;
+            else if (id != 0) {
+                deletions++;
+                if (lrat.is_open()) lrat << last_id << " d " << id << " 0\n";
+            }
+            continue;
+        }
+
+        lemmas++;
+        bool rat;
+        if (!checker.check(lits, &hints, &rat)) {
+            cout << "c Lemma " << lemmas << " is neither RUP nor RAT:";
+            for (uint32_t lit : lits) cout << " " << (lit_positive(lit) ? "" : "-") << lit_var(lit);
+            cout << endl;
+            break;
+        }
+        if (rat && lrat.is_open()) {
+            cout << "c Lemma " << lemmas << " needs RAT, LRAT output stopped" << endl;
+            lrat.close();
+        }
+
+        last_id = checker.add(lits);
+        if (lrat.is_open()) {
+            lrat << last_id;
+            for (uint32_t lit : lits) lrat << " " << (lit_positive(lit) ? "" : "-") << lit_var(lit);
+            lrat << " 0";
+            for (uint64_t h : hints) lrat << " " << h;
+            lrat << " 0\n";
+        }
+        verified = checker.refuted;
+    }
+
+    cout << "c Proof: " << lemmas << " lemmas, " << deletions << " deletions";
+    if (ignored > 0) cout << ", " << ignored << " deletions of missing clauses ignored";
+    cout << endl;
+    cout << (verified ? "s VERIFIED" : "s NOT VERIFIED") << endl;
+    return verified;
+}
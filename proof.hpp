@@ -0,0 +1,39 @@
+#ifndef PROOF_H
+#define PROOF_H
+
+#include "SAT-solver.hpp"
+#include "cdcl.hpp"
+
+// Size of the output buffer of a proof, flushed when full
+const size_t PROOF_BUFFER_SIZE = 1 << 20;
+
+/**
+ * Writes a DRAT proof, in the binary encoding or as text, through a large buffer.
+ * Literals are codes 2*var for var and 2*var+1 for its negation, which is also the binary
+ * DRAT mapping, so clauses of the CDCL solver are written without conversion.
+*/
+class ProofWriter {
+    public:
+        ProofWriter(string filename, bool binary = true);
+        ~ProofWriter();
+        bool is_open() { return output.is_open(); }
+        void add(const uint32_t *lits, size_t size) { write_clause('a', lits, size); lemmas++; }
+        void remove(const uint32_t *lits, size_t size) { write_clause('d', lits, size); deletions++; }
+        void add(const vector<uint32_t> &lits) { add(lits.data(), lits.size()); }
+        void remove(const vector<uint32_t> &lits) { remove(lits.data(), lits.size()); }
+        void flush();
+        uint64_t lemmas = 0;
+        uint64_t deletions = 0;
+        uint64_t bytes = 0;
+    private:
+        ofstream output;
+        bool binary;
+        char *buffer;
+        size_t used = 0;
+
+        void write_clause(char tag, const uint32_t *lits, size_t size);
+};
+
+bool check_proof(Clause **clause_set, int n, string proof_file, string lrat_file);
+
+#endif
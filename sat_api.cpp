@@ -0,0 +1,113 @@
+#include "sat_api.hpp"
+
+static uint32_t dimacs_to_lit(int lit) {
+    return lit > 0 ? mk_lit(lit, true) : mk_lit(-lit, false);
+}
+
+static int lit_to_dimacs(uint32_t lit) {
+    return lit_positive(lit) ? (int)lit_var(lit) : -(int)lit_var(lit);
+}
+
+static bool valid_literal(int lit) {
+    return lit != 0 && lit >= -SAT_API_MAX_VAR && lit <= SAT_API_MAX_VAR;
+}
+
+SatSolver::SatSolver() {}
+
+/**
+ * Adds a clause. Returns false, adding nothing, if a literal is 0 or out of range.
+*/
+bool SatSolver::add_clause(const vector<int> &lits) {
+    vector<uint32_t> codes;
+    codes.reserve(lits.size());
+    for (int lit : lits) {
+        if (!valid_literal(lit)) return false;
+        codes.push_back(dimacs_to_lit(lit));
+    }
+
+    solver.add_clause(codes);
+    clause_count++;
+    return true;
+}
+
+/**
+ * Adds every clause of a DIMACS CNF file.
+ * Returns false, adding nothing, if the file cannot be read or is malformed.
+*/
+bool SatSolver::add_dimacs_file(string filename) {
+    int n;
+    Clause **clause_set = read_cnf_file(filename, &n);
+    if (clause_set == NULL) return false;
+
+    vector<vector<int>> clauses(n);
+    bool ok = true;
+    for (int i = 0; i < n; i++) {
+        for (int j = 0; j < clause_set[i]->n; j++) {
+            literal lit = clause_set[i]->literals[j];
+            if (lit.var > (uint32_t)SAT_API_MAX_VAR) ok = false;
+            clauses[i].push_back(lit.positive ? (int)lit.var : -(int)lit.var);
+        }
+    }
+    free_clause_set(clause_set, n);
+    if (!ok) return false;
+
+    for (const vector<int> &lits : clauses)
+        add_clause(lits);
+    return true;
+}
+
+/**
+ * Solves the clauses added so far under the given assumptions.
+ * Returns CDCL_SAT, CDCL_UNSAT, or CDCL_UNKNOWN if the search was stopped
+ * or ran out of the limits, which apply to each call separately.
+ * Returns SAT_API_INVALID if an assumption is 0 or out of range.
+*/
+int SatSolver::solve(const vector<int> &assumptions) {
+    vector<uint32_t> codes;
+    codes.reserve(assumptions.size());
+    for (int lit : assumptions) {
+        if (!valid_literal(lit)) return SAT_API_INVALID;
+        codes.push_back(dimacs_to_lit(lit));
+    }
+
+    SearchBudget budget(limits);
+    solver.budget = &budget;
+    last_result = solver.solve(codes);
+    solver.budget = NULL;
+    return last_result;
+}
+
+/**
+ * Value of a literal in the model of the last satisfiable call.
+*/
+bool SatSolver::value(int lit) {
+    if (!valid_literal(lit)) return false;
+    bool val = solver.model_value(lit > 0 ? lit : -lit);
+    return lit > 0 ? val : !val;
+}
+
+vector<int> SatSolver::model() {
+    vector<int> lits;
+    if (last_result != CDCL_SAT) return lits;
+    for (uint32_t v = 1; v <= solver.num_vars(); v++)
+        lits.push_back(solver.model_value(v) ? (int)v : -(int)v);
+    return lits;
+}
+
+/**
+ * Determines whether an assumption of the last unsatisfiable call was used to refute the formula.
+*/
+bool SatSolver::failed(int lit) {
+    return last_result == CDCL_UNSAT && valid_literal(lit) && solver.is_failed(dimacs_to_lit(lit));
+}
+
+vector<int> SatSolver::failed_assumptions() {
+    vector<int> lits;
+    if (last_result != CDCL_UNSAT) return lits;
+    for (uint32_t lit : solver.failed()) lits.push_back(lit_to_dimacs(lit));
+    return lits;
+}
+
+uint32_t SatSolver::num_vars() {
+    return solver.num_vars();
+}
@@ -0,0 +1,47 @@
+#ifndef SAT_API_H
+#define SAT_API_H
+
+#include "cdcl.hpp"
+
+// Largest variable a DIMACS literal may use
+const int SAT_API_MAX_VAR = (1 << 30) - 1;
+// Returned by solve() when an assumption is 0 or out of range
+const int SAT_API_INVALID = -1;
+
+/**
+ * Embeddable incremental SAT solver.
+ * Literals are DIMACS integers: v for variable v, -v for its negation.
+ * Clauses can be added at any time between calls to solve(); everything the solver has learnt
+ * is kept, so repeated queries on the same base formula only pay for what changed.
+ *
+ *     SatSolver solver;
+ *     solver.add_clause({1, 2});
+ *     solver.add_clause({-1, 2});
+ *     if (solver.solve({-2}) == CDCL_UNSAT) solver.failed_assumptions();  // {-2}
+ *     solver.solve();                                                       // CDCL_SAT, value(2)
+ *
+ * Literal 0 and literals over variables above SAT_API_MAX_VAR are rejected, and unreadable or
+ * malformed files are reported, without changing the solver.
+*/
+class SatSolver {
+    public:
+        SatSolver();
+        bool add_clause(const vector<int> &lits);
+        bool add_dimacs_file(string filename);
+        int solve(const vector<int> &assumptions = vector<int>());
+        bool value(int lit);
+        vector<int> model();
+        bool failed(int lit);
+        vector<int> failed_assumptions();
+        uint32_t num_vars();
+        uint64_t num_clauses() { return clause_count; }
+        void set_stop_flag(atomic<bool> *stop) { solver.stop = stop; }
+        void set_limits(const solve_limits &limits) { this->limits = limits; }
+    private:
+        CdclSolver solver;
+        solve_limits limits;
+        uint64_t clause_count = 0;
+        int last_result = CDCL_UNKNOWN;
+};
+
+#endif
@@ -0,0 +1,409 @@
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <poll.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <cerrno>
+#include "server.hpp"
+
+/**
+ * Header line of a request: the payload format and size. Returns false if it is malformed.
+*/
+static bool parse_header(const string &header, istringstream *words, string *format, uint64_t *size) {
+    words->str(header);
+    return (*words >> *format >> *size) && (*format == "dimacs" || *format == "binary");
+}
+
+/**
+ * Appends what the client sent, once poll() found the socket readable. Returns false when the client
+ * closed the connection or it failed.
+*/
+bool Connection::receive() {
+    char buffer[65536];
+    ssize_t n = read(fd, buffer, sizeof(buffer));
+    if (n < 0) return errno == EINTR || errno == EAGAIN;
+    if (n == 0) return false;
+
+    // Drops the consumed requests before the buffer grows
+    if (pos > 0) {
+        input.erase(0, pos);
+        pos = 0;
+    }
+    input.append(buffer, n);
+    last_received = chrono::steady_clock::now();
+    return true;
+}
+
+/**
+ * Whether the next request is buffered in full, skipping the blank lines before it. A malformed
+ * or overlong header line counts as a request, which the worker answers with an 'e' line.
+*/
+bool Connection::request_ready() {
+    while (pos < input.size() && (input[pos] == '\n' || input[pos] == '\r')) pos++;
+    size_t eol = input.find('\n', pos);
+    if (eol == string::npos) return input.size() - pos > 4096;
+
+    istringstream words;
+    string format;
+    uint64_t size;
+    if (!parse_header(input.substr(pos, eol - pos), &words, &format, &size) || size > SERVER_MAX_PAYLOAD) return true;
+    return input.size() - (eol + 1) >= size;
+}
+
+/**
+ * Whether a request was started and then nothing more arrived for SERVER_READ_TIMEOUT_MS.
+*/
+bool Connection::stalled() {
+    return pos < input.size() &&
+           chrono::steady_clock::now() - last_received > chrono::milliseconds(SERVER_READ_TIMEOUT_MS);
+}
+
+/**
+ * Reads one buffered line without its line ending. Lines longer than 4096 characters are rejected.
+*/
+bool Connection::read_line(string *line) {
+    size_t eol = input.find('\n', pos);
+    if (eol == string::npos || eol - pos > 4096) return false;
+    line->assign(input, pos, eol - pos);
+    pos = eol + 1;
+    if (!line->empty() && line->back() == '\r') line->pop_back();
+    return true;
+}
+
+/**
+ * Reads exactly n buffered bytes. The buffer only holds what the client sent, never the size a header announced.
+*/
+bool Connection::read_bytes(uint64_t n, string *bytes) {
+    if (input.size() - pos < n) return false;
+    bytes->assign(input, pos, n);
+    pos += n;
+    return true;
+}
+
+static bool write_all(int fd, const string &data) {
+    size_t done = 0;
+    while (done < data.size()) {
+        ssize_t n = send(fd, data.data() + done, data.size() - done, MSG_NOSIGNAL);
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) return false;
+        done += n;
+    }
+    return true;
+}
+
+/**
+ * Parses DIMACS CNF text. Comment lines and the header are skipped, apart from the
+ * declared number of variables; a last clause without its 0 is accepted.
+*/
+static bool parse_dimacs(const string &text, vector<vector<int>> *clauses, uint32_t *declared, string *error) {
+    const char *p = text.c_str();
+    const char *end = p + text.size();
+    vector<int> clause;
+
+    while (p < end) {
+        if (*p == ' ' || *p == '\t' || *p == '\r' || *p == '\n') {
+            p++;
+        } else if (*p == 'c' || *p == 'p' || *p == '%') {
+            const char *eol = (const char *)memchr(p, '\n', end - p);
+            if (eol == NULL) eol = end;
+            if (*p == 'p') {
+                unsigned long v;
+                if (sscanf(string(p, eol).c_str(), "p cnf %lu", &v) != 1) {
+                    *error = "malformed header";
+                    return false;
+                }
+                *declared = v;
+            }
+            p = eol;
+        } else {
+            char *next;
+            errno = 0;
+            long lit = strtol(p, &next, 10);
+            if (next == p || errno != 0 || lit < -SAT_API_MAX_VAR || lit > SAT_API_MAX_VAR) {
+                *error = "invalid literal";
+                return false;
+            }
+            p = next;
+            if (lit == 0) {
+                clauses->push_back(clause);
+                clause.clear();
+            } else {
+                clause.push_back(lit);
+            }
+        }
+    }
+    if (!clause.empty()) clauses->push_back(clause);
+    return true;
+}
+
+/**
+ * Parses a clause set of little-endian 32-bit literals, each clause ended by 0.
+*/
+static bool parse_binary(const string &bytes, vector<vector<int>> *clauses, string *error) {
+    if (bytes.size() % 4 != 0) {
+        *error = "binary payload is not a whole number of literals";
+        return false;
+    }
+
+    vector<int> clause;
+    const unsigned char *b = (const unsigned char *)bytes.data();
+    for (size_t i = 0; i < bytes.size(); i += 4) {
+        int32_t lit = (int32_t)(b[i] | (b[i+1] << 8) | (b[i+2] << 16) | ((uint32_t)b[i+3] << 24));
+        if (lit < -SAT_API_MAX_VAR || lit > SAT_API_MAX_VAR) {
+            *error = "invalid literal";
+            return false;
+        }
+        if (lit == 0) {
+            clauses->push_back(clause);
+            clause.clear();
+        } else {
+            clause.push_back(lit);
+        }
+    }
+    if (!clause.empty()) clauses->push_back(clause);
+    return true;
+}
+
+/**
+ * Lowers a limit to the value asked for by a request, unless the server's own limit is smaller.
+*/
+template <typename T>
+static void request_limit(T *limit, T requested) {
+    if (*limit == 0 || requested < *limit) *limit = requested;
+}
+
+SolverServer::SolverServer(string socket_path, int num_workers, const solve_limits &limits) {
+    this->socket_path = socket_path;
+    this->num_workers = num_workers;
+    this->limits = limits;
+}
+
+/**
+ * Reads the payload of a request, solves it and returns the answer.
+ * keep_open becomes false if the request cannot be framed, since the rest of the stream is then unusable.
+*/
+string SolverServer::answer(const string &header, Connection *connection, bool *keep_open) {
+    istringstream words;
+    string format;
+    uint64_t size;
+    if (!parse_header(header, &words, &format, &size)) {
+        *keep_open = false;
+        return "e expected dimacs BYTES or binary BYTES\n";
+    }
+    if (size > SERVER_MAX_PAYLOAD) {
+        *keep_open = false;
+        return "e payload too large\n";
+    }
+
+    string payload;
+    if (!connection->read_bytes(size, &payload)) {
+        *keep_open = false;
+        return "";
+    }
+
+    solve_limits request = limits;
+    string key;
+    while (words >> key) {
+        double value;
+        if (!(words >> value) || value <= 0) return "e invalid value of " + key + "\n";
+        if (key == "time-limit") request_limit(&request.time_limit, value);
+        else if (key == "decision-limit") request_limit(&request.max_decisions, (uint64_t)value);
+        else if (key == "propagation-limit") request_limit(&request.max_propagations, (uint64_t)value);
+        else return "e unknown option " + key + "\n";
+    }
+
+    vector<vector<int>> clauses;
+    uint32_t declared = 0;
+    string error;
+    bool parsed = format == "dimacs" ? parse_dimacs(payload, &clauses, &declared, &error) : parse_binary(payload, &clauses, &error);
+    if (!parsed) return "e " + error + "\n";
+
+    SatSolver solver;
+    solver.set_limits(request);
+    for (const vector<int> &clause : clauses) solver.add_clause(clause);
+
+    int res = solver.solve();
+    if (res == CDCL_UNSAT) return "s UNSATISFIABLE\n";
+    if (res != CDCL_SAT) return "s UNKNOWN\n";
+
+    // Variables declared but in no clause are false, as in the command line output
+    string out = "s SATISFIABLE\nv ";
+    vector<int> model = solver.model();
+    for (uint32_t v = model.size() + 1; v <= declared; v++) model.push_back(-(int)v);
+
+    // The model is checked against the clauses of the request before it is sent
+    for (const vector<int> &clause : clauses) {
+        bool satisfied = false;
+        for (int lit : clause) satisfied = satisfied || (abs(lit) <= (int)model.size() && model[abs(lit) - 1] == lit);
+        if (!satisfied) return "s UNKNOWN\n";
+    }
+    for (int lit : model) out += to_string(lit) + " ";
+    out += "0\n";
+    return out;
+}
+
+/**
+ * Answers the buffered request of a connection. Returns false once the connection is to be closed:
+ * the request could not be framed or the answer could not be sent.
+*/
+bool SolverServer::serve(Connection *connection) {
+    string line;
+    if (!connection->read_line(&line)) return false;
+
+    bool keep_open = true;
+    string out;
+    try {
+        out = answer(line, connection, &keep_open);
+    } catch (const bad_alloc &) {
+        // The payload may not have been consumed, so the rest of the stream cannot be framed
+        out = "e out of memory\n";
+        keep_open = false;
+    }
+    requests.fetch_add(1);
+    return write_all(connection->descriptor(), out) && keep_open;
+}
+
+void SolverServer::worker() {
+    while (true) {
+        Connection *connection;
+        {
+            unique_lock<mutex> guard(queue_lock);
+            queue_ready.wait(guard, [this] { return closing || !ready.empty(); });
+            if (closing) return;
+            connection = ready.front();
+            ready.pop_front();
+        }
+
+        if (!serve(connection)) {
+            close(connection->descriptor());
+            delete connection;
+            continue;
+        }
+        {
+            lock_guard<mutex> guard(queue_lock);
+            returned.push_back(connection);
+        }
+        ssize_t n = write(wake_pipe[1], "", 1);
+        (void)n;
+    }
+}
+
+/**
+ * Listens on the socket path, replacing a stale socket left there, and hands every whole request
+ * to the workers until the terminate flag of the limits is set.
+ * Returns false if the socket cannot be set up.
+*/
+bool SolverServer::run() {
+    struct sockaddr_un addr;
+    if (socket_path.size() >= sizeof(addr.sun_path)) {
+        cerr << "Error: socket path too long: " << socket_path << endl;
+        return false;
+    }
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    strcpy(addr.sun_path, socket_path.c_str());
+
+    struct stat st;
+    if (stat(socket_path.c_str(), &st) == 0 && S_ISSOCK(st.st_mode)) unlink(socket_path.c_str());
+
+    int listen_fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (listen_fd < 0 || bind(listen_fd, (struct sockaddr *)&addr, sizeof(addr)) < 0 || listen(listen_fd, 128) < 0) {
+        cerr << "Error: cannot listen on " << socket_path << ": " << strerror(errno) << endl;
+        if (listen_fd >= 0) close(listen_fd);
+        return false;
+    }
+    if (pipe(wake_pipe) < 0) {
+        cerr << "Error: cannot create the wake-up pipe: " << strerror(errno) << endl;
+        close(listen_fd);
+        return false;
+    }
+    fcntl(wake_pipe[0], F_SETFL, O_NONBLOCK);
+    fcntl(wake_pipe[1], F_SETFL, O_NONBLOCK);
+    cout << "c Listening on " << socket_path << " with " << num_workers << " workers" << endl;
+
+    vector<thread> threads;
+    for (int i = 0; i < num_workers; i++)
+        threads.push_back(thread(&SolverServer::worker, this));
+
+    // Connections between requests, watched here rather than by a worker
+    vector<Connection*> idle;
+    while (limits.terminate == NULL || !limits.terminate->load()) {
+        vector<struct pollfd> fds = {{listen_fd, POLLIN, 0}, {wake_pipe[0], POLLIN, 0}};
+        for (Connection *connection : idle)
+            fds.push_back({connection->descriptor(), POLLIN, 0});
+        if (poll(fds.data(), fds.size(), 100) < 0 && errno != EINTR) break;
+
+        // Whole requests go to the workers; closed connections and stalled requests are dropped
+        vector<Connection*> waiting, complete;
+        for (size_t i = 0; i < idle.size(); i++) {
+            Connection *connection = idle[i];
+            bool open = true;
+            if (fds[i + 2].revents != 0) {
+                try {
+                    open = connection->receive();
+                } catch (const bad_alloc &) {
+                    open = false;
+                }
+            }
+            if (connection->request_ready()) {
+                complete.push_back(connection);
+            } else if (!open || connection->stalled()) {
+                close(connection->descriptor());
+                delete connection;
+            } else {
+                waiting.push_back(connection);
+            }
+        }
+
+        if (fds[0].revents != 0) {
+            int fd = accept(listen_fd, NULL, NULL);
+            if (fd >= 0) waiting.push_back(new Connection(fd));
+        }
+        if (fds[1].revents != 0) {
+            char drain[256];
+            while (read(wake_pipe[0], drain, sizeof(drain)) > 0);
+        }
+
+        lock_guard<mutex> guard(queue_lock);
+        // Pipelined requests may already be buffered in the connections handed back
+        for (Connection *connection : returned) {
+            if (connection->request_ready()) complete.push_back(connection);
+            else waiting.push_back(connection);
+        }
+        returned.clear();
+        idle = waiting;
+        if (complete.empty()) continue;
+        ready.insert(ready.end(), complete.begin(), complete.end());
+        queue_ready.notify_all();
+    }
+
+    {
+        lock_guard<mutex> guard(queue_lock);
+        closing = true;
+        queue_ready.notify_all();
+    }
+    for (thread &t : threads)
+        t.join();
+    idle.insert(idle.end(), ready.begin(), ready.end());
+    idle.insert(idle.end(), returned.begin(), returned.end());
+    for (Connection *connection : idle) {
+        close(connection->descriptor());
+        delete connection;
+    }
+    close(wake_pipe[0]);
+    close(wake_pipe[1]);
+    close(listen_fd);
+    unlink(socket_path.c_str());
+    return true;
+}
+
+/**
+ * Runs the solver daemon until it is interrupted. Returns the exit status of the process.
+*/
+int run_server(string socket_path, int num_workers, const solve_limits &limits) {
+    SolverServer server(socket_path, num_workers, limits);
+    if (!server.run()) return 1;
+    cout << "c Served " << server.requests.load() << " requests" << endl;
+    return 0;
+}
@@ -0,0 +1,74 @@
+#ifndef SERVER_H
+#define SERVER_H
+
+#include <deque>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include "sat_api.hpp"
+
+// Largest payload a request may announce, in bytes
+const uint64_t SERVER_MAX_PAYLOAD = 1ull << 30;
+// Longest silence in the middle of a request, in milliseconds, before the connection is dropped
+const int SERVER_READ_TIMEOUT_MS = 10000;
+
+/**
+ * Client connection with the bytes received on it and not yet consumed. The listening thread
+ * receives into it until a whole request is buffered; the worker answering the request then
+ * reads it from the buffer without waiting on the socket.
+*/
+class Connection {
+    public:
+        Connection(int fd) : fd(fd) {}
+        int descriptor() { return fd; }
+        bool receive();
+        bool request_ready();
+        bool stalled();
+        bool read_line(string *line);
+        bool read_bytes(uint64_t n, string *bytes);
+    private:
+        int fd;
+        string input;
+        size_t pos = 0;
+        chrono::steady_clock::time_point last_received;
+};
+
+/**
+ * Long-lived solver process listening on a Unix domain socket.
+ * The listening thread polls every connection between its requests and buffers what arrives; once a
+ * whole request is in, the connection is queued for a fixed pool of workers. A worker answers that one
+ * request and hands the connection back, so neither idle nor slow clients hold a worker.
+ *
+ * A request is one line, "dimacs BYTES" or "binary BYTES", optionally followed by
+ * "time-limit S", "decision-limit N" and "propagation-limit N", then BYTES bytes of payload:
+ * DIMACS CNF text, or little-endian 32-bit literals with each clause ended by 0.
+ * The answer is an 's' line, followed by a 'v' line for a satisfiable formula,
+ * or an 'e' line describing a malformed request.
+ * Limits given on the command line are the defaults and upper bounds of the per-request limits.
+*/
+class SolverServer {
+    public:
+        SolverServer(string socket_path, int num_workers, const solve_limits &limits);
+        bool run();
+        atomic<uint64_t> requests{0};
+    private:
+        string socket_path;
+        int num_workers;
+        solve_limits limits;
+        mutex queue_lock;
+        condition_variable queue_ready;
+        // Connections with a request to read, and those handed back by the workers
+        deque<Connection*> ready;
+        vector<Connection*> returned;
+        bool closing = false;
+        // Written by the workers to wake the listening thread when they hand a connection back
+        int wake_pipe[2];
+
+        void worker();
+        bool serve(Connection *connection);
+        string answer(const string &header, Connection *connection, bool *keep_open);
+};
+
+int run_server(string socket_path, int num_workers, const solve_limits &limits);
+
+#endif
@@ -0,0 +1,56 @@
+#include "share_ring.hpp"
+
+ShareRing::ShareRing() {
+    slots = new ShareSlot[SHARE_RING_CAPACITY];
+}
+
+ShareRing::~ShareRing() {
+    delete []slots;
+}
+
+/**
+ * Publishes a clause of at most SHARE_MAX_SIZE literals, overwriting the oldest one.
+ * Must only be called by the owning thread.
+*/
+void ShareRing::push(const uint32_t *lits, uint32_t size) {
+    uint64_t idx = head.load(memory_order_relaxed);
+    ShareSlot *slot = &slots[idx & (SHARE_RING_CAPACITY - 1)];
+
+    slot->seq.store(2*idx + 1, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+    slot->size.store(size, memory_order_relaxed);
+    for (uint32_t i = 0; i < size; i++)
+        slot->lits[i].store(lits[i], memory_order_relaxed);
+    slot->seq.store(2*idx + 2, memory_order_release);
+
+    head.store(idx + 1, memory_order_release);
+}
+
+/**
+ * Copies the clause with the given index.
+ * Returns false if the slot has already been reused for a newer clause.
+*/
+bool ShareRing::read(uint64_t idx, uint32_t *lits, uint32_t *size) {
+    ShareSlot *slot = &slots[idx & (SHARE_RING_CAPACITY - 1)];
+
+    uint64_t seq = slot->seq.load(memory_order_acquire);
+    if (seq != 2*idx + 2) return false;
+
+    *size = slot->size.load(memory_order_relaxed);
+    if (*size > SHARE_MAX_SIZE) return false;
+    for (uint32_t i = 0; i < *size; i++)
+        lits[i] = slot->lits[i].load(memory_order_relaxed);
+
+    atomic_thread_fence(memory_order_acquire);
+    return slot->seq.load(memory_order_relaxed) == seq;
+}
+
+SharedClauses::SharedClauses(int num_threads) {
+    for (int i = 0; i < num_threads; i++)
+        rings.push_back(new ShareRing());
+}
+
+SharedClauses::~SharedClauses() {
+    for (ShareRing *ring : rings)
+        delete ring;
+}
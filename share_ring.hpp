@@ -0,0 +1,45 @@
+#ifndef SHARE_RING_H
+#define SHARE_RING_H
+
+#include <atomic>
+#include <cstdint>
+#include <vector>
+using namespace std;
+
+// Longest clause that can be exchanged between threads
+const uint32_t SHARE_MAX_SIZE = 8;
+// Number of slots in each ring, a power of two
+const uint64_t SHARE_RING_CAPACITY = 1 << 12;
+
+struct ShareSlot {
+    // 2*idx+1 while clause idx is being written, 2*idx+2 once it is complete
+    atomic<uint64_t> seq{0};
+    atomic<uint32_t> size{0};
+    atomic<uint32_t> lits[SHARE_MAX_SIZE];
+};
+
+/**
+ * Single-producer, multi-consumer broadcast ring of short clauses.
+ * Only the owning thread writes; any thread may read any index it has not consumed yet.
+ * Slots are protected by a sequence counter instead of a lock: a reader detects a slot that was
+ * overwritten while it was being copied and drops the clause, which is always safe for learned clauses.
+*/
+class ShareRing {
+    public:
+        ShareRing();
+        ~ShareRing();
+        void push(const uint32_t *lits, uint32_t size);
+        bool read(uint64_t idx, uint32_t *lits, uint32_t *size);
+        uint64_t published() { return head.load(memory_order_acquire); }
+    private:
+        ShareSlot *slots;
+        atomic<uint64_t> head{0};
+};
+
+struct SharedClauses {
+    vector<ShareRing*> rings;
+    SharedClauses(int num_threads);
+    ~SharedClauses();
+};
+
+#endif
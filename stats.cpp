@@ -0,0 +1,151 @@
+#include <iostream>
+#include <sstream>
+#include <vector>
+#include <sys/resource.h>
+#include "stats.hpp"
+#include "memory.hpp"
+#include "pool.hpp"
+
+// Counters of the live threads, and the sums of the threads that have exited
+static mutex registry_lock;
+static vector<ThreadStats*> registry;
+static uint64_t retired_conflicts = 0;
+static uint64_t retired_restarts = 0;
+static uint64_t retired_max_depth = 0;
+
+// Set by the SIGUSR1 handler, cleared by the reporter that prints
+static atomic<bool> dump_requested{false};
+
+thread_local ThreadStats thread_stats;
+
+ThreadStats::ThreadStats() {
+    lock_guard<mutex> guard(registry_lock);
+    registry.push_back(this);
+}
+
+ThreadStats::~ThreadStats() {
+    lock_guard<mutex> guard(registry_lock);
+    retired_conflicts += conflicts.load();
+    retired_restarts += restarts.load();
+    retired_max_depth = max(retired_max_depth, max_depth.load());
+    for (size_t i = 0; i < registry.size(); i++) {
+        if (registry[i] == this) {
+            registry[i] = registry.back();
+            registry.pop_back();
+            break;
+        }
+    }
+}
+
+/**
+ * Asks the running reporter for a progress line. Only sets a flag, so it is safe in a signal handler.
+*/
+void request_stats_dump() {
+    dump_requested.store(true);
+}
+
+/**
+ * Largest resident memory of the process so far.
+*/
+uint64_t peak_memory_bytes() {
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0) return 0;
+    return (uint64_t)usage.ru_maxrss * 1024;
+}
+
+ProgressReporter::ProgressReporter(SearchBudget *budget, double interval, bool summary) {
+    this->budget = budget;
+    this->interval = interval;
+    this->summary = summary;
+
+    // The maximum depth starts over, the other counters are taken relative to now
+    {
+        lock_guard<mutex> guard(registry_lock);
+        retired_max_depth = 0;
+        for (ThreadStats *s : registry) s->max_depth.store(0);
+    }
+    base = snapshot();
+    last = base;
+    reporter = thread(&ProgressReporter::run, this);
+}
+
+ProgressReporter::~ProgressReporter() {
+    {
+        lock_guard<mutex> guard(lock);
+        done = true;
+        wake.notify_all();
+    }
+    reporter.join();
+    if (!summary) return;
+
+    stats_snapshot now = snapshot();
+    double seconds = max(now.seconds, 1e-9);
+    ostringstream out;
+    out << "c Statistics after " << now.seconds << " s:\n";
+    out << "c   decisions " << now.decisions << " (" << (uint64_t)(now.decisions / seconds) << "/s), propagations "
+        << now.propagations << " (" << (uint64_t)(now.propagations / seconds) << "/s), conflicts " << now.conflicts
+        << " (" << (uint64_t)(now.conflicts / seconds) << "/s)\n";
+    out << "c   restarts " << now.restarts << ", max depth " << now.max_depth;
+    pool_statistics pool = get_pool_statistics();
+    if (pool.allocations > 0)
+        out << "\nc   pool allocations " << pool.allocations << ", " << (int)(100.0 * pool.reused / pool.allocations) << "% reused";
+    cout << out.str() << endl;
+    print_memory_report();
+}
+
+/**
+ * Counters of all threads since the reporter started. Decisions and propagations are the totals
+ * of the budget, which threads add in batches.
+*/
+stats_snapshot ProgressReporter::snapshot() {
+    stats_snapshot s;
+    s.seconds = budget->elapsed();
+    s.decisions = budget->total_decisions();
+    s.propagations = budget->total_propagations();
+
+    lock_guard<mutex> guard(registry_lock);
+    s.conflicts = retired_conflicts;
+    s.restarts = retired_restarts;
+    s.max_depth = retired_max_depth;
+    for (ThreadStats *t : registry) {
+        s.conflicts += t->conflicts.load(memory_order_relaxed);
+        s.restarts += t->restarts.load(memory_order_relaxed);
+        s.max_depth = max(s.max_depth, t->max_depth.load(memory_order_relaxed));
+    }
+    s.conflicts -= base.conflicts;
+    s.restarts -= base.restarts;
+    return s;
+}
+
+/**
+ * Prints the counters, with the rates since the previous progress line.
+*/
+void ProgressReporter::print_progress() {
+    stats_snapshot now = snapshot();
+    double seconds = max(now.seconds - last.seconds, 1e-9);
+
+    ostringstream out;
+    out << "c progress " << now.seconds << " s: decisions " << now.decisions << " ("
+        << (uint64_t)((now.decisions - last.decisions) / seconds) << "/s), propagations " << now.propagations << " ("
+        << (uint64_t)((now.propagations - last.propagations) / seconds) << "/s), conflicts " << now.conflicts << " ("
+        << (uint64_t)((now.conflicts - last.conflicts) / seconds) << "/s), restarts " << now.restarts
+        << ", max depth " << now.max_depth << ", memory " << resident_memory_bytes() / (1024 * 1024) << " MB";
+    cout << out.str() << endl;
+    last = now;
+}
+
+void ProgressReporter::run() {
+    double next = interval;
+    unique_lock<mutex> guard(lock);
+    while (!done) {
+        wake.wait_for(guard, chrono::milliseconds(100));
+        if (done) break;
+
+        bool dump = dump_requested.exchange(false);
+        bool due = interval > 0 && budget->elapsed() >= next;
+        if (due) {
+            while (next <= budget->elapsed()) next += interval;
+        }
+        if (dump || due) print_progress();
+    }
+}
@@ -0,0 +1,76 @@
+#ifndef STATS_H
+#define STATS_H
+
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <condition_variable>
+#include "limits.hpp"
+
+/**
+ * Search counters of one thread, besides the decisions and propagations the budget already totals.
+ * Only the owning thread writes them, with relaxed loads and stores that compile to plain memory
+ * accesses, so counting costs no more than a local counter while the reporter reads them at any time.
+*/
+struct ThreadStats {
+    atomic<uint64_t> conflicts{0};
+    atomic<uint64_t> restarts{0};
+    atomic<uint64_t> max_depth{0};
+    ThreadStats();
+    ~ThreadStats();
+};
+
+extern thread_local ThreadStats thread_stats;
+
+inline void count_conflict() {
+    thread_stats.conflicts.store(thread_stats.conflicts.load(memory_order_relaxed) + 1, memory_order_relaxed);
+}
+
+inline void count_restart() {
+    thread_stats.restarts.store(thread_stats.restarts.load(memory_order_relaxed) + 1, memory_order_relaxed);
+}
+
+inline void note_depth(uint64_t depth) {
+    if (depth > thread_stats.max_depth.load(memory_order_relaxed)) thread_stats.max_depth.store(depth, memory_order_relaxed);
+}
+
+struct stats_snapshot {
+    double seconds = 0;
+    uint64_t decisions = 0;
+    uint64_t propagations = 0;
+    uint64_t conflicts = 0;
+    uint64_t restarts = 0;
+    uint64_t max_depth = 0;
+};
+
+/**
+ * Prints 'c' progress lines for the search of a budget every interval seconds, if interval is
+ * positive, and whenever SIGUSR1 asks for one. A background thread wakes every 100 ms to check;
+ * the search threads never wait for it. With summary set, the destructor prints the totals and
+ * average rates of the whole search, and the peak memory.
+*/
+class ProgressReporter {
+    public:
+        ProgressReporter(SearchBudget *budget, double interval, bool summary);
+        ~ProgressReporter();
+    private:
+        SearchBudget *budget;
+        double interval;
+        bool summary;
+        // Counters of all threads when the reporter started, subtracted from later snapshots
+        stats_snapshot base;
+        stats_snapshot last;
+        mutex lock;
+        condition_variable wake;
+        bool done = false;
+        thread reporter;
+
+        stats_snapshot snapshot();
+        void print_progress();
+        void run();
+};
+
+void request_stats_dump();
+uint64_t peak_memory_bytes();
+
+#endif
@@ -0,0 +1,55 @@
+#!/bin/sh
+# Decodes the binary DRAT proofs of the solver and compares them with its text proofs,
+# so an encoding error cannot hide behind the solver's own checker.
+# Usage: tests/proof_encoding.sh [path to SAT-solver]
+
+SOLVER=${1:-./SAT-solver}
+TMP=$(mktemp -d)
+trap 'rm -rf "$TMP"' EXIT
+
+# The default search refutes variable 1 first, so the proof starts with lemma -1: 'a' 3 0
+printf 'p cnf 2 4\n1 2 0\n1 -2 0\n-1 2 0\n-1 -2 0\n' > "$TMP/f.cnf"
+
+# Prints a binary proof in the text format
+decode() {
+    od -An -v -tu1 "$1" | awk '
+        { for (i = 1; i <= NF; i++) bytes[n++] = $i }
+        END {
+            i = 0
+            while (i < n) {
+                line = bytes[i++] == 100 ? "d " : ""
+                for (;;) {
+                    u = 0; shift = 1
+                    do { b = bytes[i++]; u += (b % 128) * shift; shift *= 128 } while (b >= 128)
+                    if (u == 0) break
+                    line = line (u % 2 ? "-" : "") int(u / 2) " "
+                }
+                print line "0"
+            }
+        }'
+}
+
+status=0
+$SOLVER -proof "$TMP/p.drat" "$TMP/f.cnf" > /dev/null
+if [ "$(od -An -tu1 -N3 "$TMP/p.drat" | tr -s ' ')" != " 97 3 0" ]; then
+    echo "FAIL: the first lemma is not encoded as 97 3 0"
+    status=1
+fi
+
+for mode in "" "-cdcl 1"; do
+    $SOLVER $mode -proof "$TMP/p.drat" "$TMP/f.cnf" > /dev/null
+    $SOLVER $mode -proof-text -proof "$TMP/p.txt" "$TMP/f.cnf" > /dev/null
+    decode "$TMP/p.drat" > "$TMP/decoded.txt"
+    if ! cmp -s "$TMP/decoded.txt" "$TMP/p.txt"; then
+        echo "FAIL: binary and text proofs differ ($mode)"
+        diff "$TMP/decoded.txt" "$TMP/p.txt"
+        status=1
+    fi
+    if ! $SOLVER -check-proof "$TMP/p.drat" "$TMP/f.cnf" | grep -q "^s VERIFIED"; then
+        echo "FAIL: binary proof not verified ($mode)"
+        status=1
+    fi
+done
+
+[ $status -eq 0 ] && echo "proof encoding: OK"
+exit $status
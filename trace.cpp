@@ -0,0 +1,146 @@
+#include <iostream>
+#include "trace.hpp"
+
+#ifdef SAT_TRACE
+
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <mutex>
+#include <vector>
+
+// Events kept per thread before the rest are dropped, 24 bytes each
+static const size_t MAX_THREAD_EVENTS = 1 << 22;
+
+struct trace_event {
+    const char *name;
+    uint64_t start;
+    uint64_t duration;
+};
+
+struct trace_thread {
+    int tid;
+    vector<trace_event> events;
+    uint64_t dropped = 0;
+};
+
+struct TraceBuffer : trace_thread {
+    TraceBuffer();
+    ~TraceBuffer();
+};
+
+static atomic<bool> tracing{false};
+static string trace_path;
+static chrono::steady_clock::time_point trace_start;
+
+// Buffers of the live threads, and the events of the threads that have exited
+static mutex registry_lock;
+static vector<TraceBuffer*> registry;
+static vector<trace_thread> retired;
+static int next_tid = 1;
+
+static thread_local TraceBuffer buffer;
+
+TraceBuffer::TraceBuffer() {
+    lock_guard<mutex> guard(registry_lock);
+    tid = next_tid++;
+    registry.push_back(this);
+}
+
+TraceBuffer::~TraceBuffer() {
+    lock_guard<mutex> guard(registry_lock);
+    for (size_t i = 0; i < registry.size(); i++) {
+        if (registry[i] == this) {
+            registry[i] = registry.back();
+            registry.pop_back();
+            break;
+        }
+    }
+    if (!events.empty() || dropped > 0) retired.push_back(move(*this));
+}
+
+static uint64_t now_ns() {
+    return chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - trace_start).count();
+}
+
+TraceScope::TraceScope(const char *name) {
+    this->name = tracing.load(memory_order_relaxed) ? name : NULL;
+    if (this->name != NULL) start = now_ns();
+}
+
+TraceScope::~TraceScope() {
+    if (name == NULL) return;
+    uint64_t end = now_ns();
+    if (buffer.events.size() >= MAX_THREAD_EVENTS) {
+        buffer.dropped++;
+        return;
+    }
+    buffer.events.push_back({name, start, end - start});
+}
+
+/**
+ * Starts recording events, to be written to path by finish_trace().
+*/
+bool start_trace(string path) {
+    trace_path = path;
+    trace_start = chrono::steady_clock::now();
+    tracing.store(true);
+    return true;
+}
+
+static void write_events(ofstream &out, const trace_thread &buf, bool *first) {
+    for (const trace_event &e : buf.events) {
+        out << (*first ? "\n" : ",\n");
+        *first = false;
+        // Microseconds, with the nanoseconds as decimals
+        out << "{\"name\":\"" << e.name << "\",\"ph\":\"X\",\"pid\":1,\"tid\":" << buf.tid
+            << ",\"ts\":" << e.start / 1000 << "." << e.start % 1000 / 100 << e.start % 100 / 10 << e.start % 10
+            << ",\"dur\":" << e.duration / 1000 << "." << e.duration % 1000 / 100 << e.duration % 100 / 10 << e.duration % 10 << "}";
+    }
+}
+
+/**
+ * Stops recording and writes the events of all threads. The search threads must have finished.
+*/
+void finish_trace() {
+    if (!tracing.exchange(false)) return;
+
+    ofstream out(trace_path);
+    if (!out) {
+        cerr << "Error: cannot write the trace to " << trace_path << endl;
+        return;
+    }
+
+    lock_guard<mutex> guard(registry_lock);
+    uint64_t events = 0;
+    uint64_t dropped = 0;
+    bool first = true;
+    out << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+    for (const TraceBuffer *buf : registry) {
+        write_events(out, *buf, &first);
+        events += buf->events.size();
+        dropped += buf->dropped;
+    }
+    for (const trace_thread &buf : retired) {
+        write_events(out, buf, &first);
+        events += buf.events.size();
+        dropped += buf.dropped;
+    }
+    out << "\n]}\n";
+
+    cout << "c Trace: " << events << " events written to " << trace_path;
+    if (dropped > 0) cout << ", " << dropped << " dropped";
+    cout << endl;
+}
+
+#else
+
+bool start_trace(string) {
+    cerr << "Error: tracing is not compiled in, build with 'make trace'" << endl;
+    return false;
+}
+
+void finish_trace() {
+}
+
+#endif
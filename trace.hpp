@@ -0,0 +1,41 @@
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <string>
+
+using namespace std;
+
+/**
+ * Timeline tracing of the hot paths, compiled in only by 'make trace', which defines SAT_TRACE.
+ * TRACE_SCOPE("name") records the time from that statement to the end of the enclosing block as one
+ * event of the calling thread; in other builds it expands to nothing. Events are kept in memory
+ * per thread and written by finish_trace() as Chrome trace-event JSON, which chrome://tracing,
+ * Perfetto and speedscope open as a timeline and a flame graph.
+*/
+#ifdef SAT_TRACE
+
+#include <cstdint>
+
+class TraceScope {
+    public:
+        TraceScope(const char *name);
+        ~TraceScope();
+    private:
+        const char *name;
+        uint64_t start;
+};
+
+#define TRACE_JOIN_(a, b) a##b
+#define TRACE_JOIN(a, b) TRACE_JOIN_(a, b)
+#define TRACE_SCOPE(name) TraceScope TRACE_JOIN(trace_scope_, __LINE__)(name)
+
+#else
+
+#define TRACE_SCOPE(name) do {} while (0)
+
+#endif
+
+bool start_trace(string path);
+void finish_trace();
+
+#endif